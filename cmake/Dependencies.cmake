@@ -3,3 +3,5 @@ include(FetchContent)
 FetchContent_Declare(eigen URL https://gitlab.com/libeigen/eigen/-/archive/5.0.0/eigen-5.0.0.tar.gz)
 
 FetchContent_MakeAvailable(eigen)
+
+find_package(Threads REQUIRED)
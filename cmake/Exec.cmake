@@ -1,6 +1,9 @@
 add_executable(coremath-curveinterpolation ${CMAKE_CURRENT_SOURCE_DIR}/tests/curveinterpolation.cpp)
 target_link_libraries(coremath-curveinterpolation PUBLIC core-math)
 
+add_executable(coremath-finitedifference ${CMAKE_CURRENT_SOURCE_DIR}/tests/finitedifference.cpp)
+target_link_libraries(coremath-finitedifference PUBLIC core-math)
+
 add_executable(coremath-optim ${CMAKE_CURRENT_SOURCE_DIR}/tests/optim.cpp)
 target_link_libraries(coremath-optim PUBLIC core-math)
 
@@ -14,4 +17,10 @@ add_executable(coremath-quadratures ${CMAKE_CURRENT_SOURCE_DIR}/tests/quadrature
 target_link_libraries(coremath-quadratures PUBLIC core-math)
 
 add_executable(coremath-regression ${CMAKE_CURRENT_SOURCE_DIR}/tests/regression.cpp)
-target_link_libraries(coremath-regression PUBLIC core-math)
\ No newline at end of file
+target_link_libraries(coremath-regression PUBLIC core-math)
+
+add_executable(coremath-surfaceinterpolation ${CMAKE_CURRENT_SOURCE_DIR}/tests/surfaceinterpolation.cpp)
+target_link_libraries(coremath-surfaceinterpolation PUBLIC core-math)
+
+add_executable(coremath-threadpool ${CMAKE_CURRENT_SOURCE_DIR}/tests/threadpool.cpp)
+target_link_libraries(coremath-threadpool PUBLIC core-math)
\ No newline at end of file
@@ -0,0 +1,178 @@
+#pragma once
+#include <array>
+#include <vector>
+#include <cmath>
+#include <type_traits>
+#include "errors.hpp"
+
+// Interpolation kernels shared by the header-only BasicCurve template and the CurveInterpolation classes.
+// The classes do not wrap BasicCurve: they keep their own (possibly borrowed) storage and call the kernels.
+// A policy defines its Segment record, builds the segments from the knots (values already stored in the
+// a coefficients) and evaluates a segment at dx = x - x_i. As for CurveInterpolation, the last knot is
+// its own segment, holding the left limits of the last interval.
+namespace CurvePolicy
+{
+    struct Linear
+    {
+        struct Segment {double a, b;};
+
+        static constexpr void build(const double* x, Segment* s, int n)
+        {
+            for (int i = 0; i < n - 1; ++i) {s[i].b = (s[i + 1].a - s[i].a) / (x[i + 1] - x[i]);}
+            s[n - 1].b = s[n - 2].b;
+        }
+        static constexpr double value(const Segment& s, double dx) {return s.a + dx * s.b;}
+        static constexpr double firstDerivative(const Segment& s, double) {return s.b;}
+        static constexpr double secondDerivative(const Segment&, double) {return 0.0;}
+    };
+
+    struct Cubic
+    {
+        // Packed Horner coefficients of one segment, a + b dx + c dx^2 + d dx^3. At 32 bytes and 32-byte
+        // alignment a segment never straddles a cache line.
+        struct alignas(32) Segment {double a, b, c, d;};
+
+        // Natural cubic spline. The forward sweep keeps mu in the d coefficients and z in the c ones, so
+        // that no scratch memory is needed; the arithmetic is the one of CubicSpline's factorization.
+        static constexpr void build(const double* x, Segment* s, int n)
+        {
+            int last = n - 1;
+            s[0].c = 0.0;
+            s[0].d = 0.0;
+            for (int i = 1; i < last; ++i) {
+                double inverseL = 1.0 / (2.0 * (x[i + 1] - x[i - 1]) - (x[i] - x[i - 1]) * s[i - 1].d);
+                double alpha = 3.0 * ((s[i + 1].a - s[i].a) * (1.0 / (x[i + 1] - x[i])) - (s[i].a - s[i - 1].a) * (1.0 / (x[i] - x[i - 1])));
+                s[i].d = (x[i + 1] - x[i]) * inverseL;
+                s[i].c = (alpha - (x[i] - x[i - 1]) * s[i - 1].c) * inverseL;
+            }
+            s[last].c = 0.0;
+            for (int j = last - 1; j >= 0; --j) {
+                double h = x[j + 1] - x[j], inverseH = 1.0 / h;
+                s[j].c -= s[j].d * s[j + 1].c;
+                s[j].b = (s[j + 1].a - s[j].a) * inverseH - h * (s[j + 1].c + 2.0 * s[j].c) / 3.0;
+                s[j].d = (s[j + 1].c - s[j].c) * inverseH / 3.0;
+            }
+            closeLastSegment(x, s, n);
+        }
+
+        // Right-end slope of the last cubic, natural boundary (c = d = 0).
+        static constexpr void closeLastSegment(const double* x, Segment* s, int n)
+        {
+            int last = n - 1;
+            double h = x[last] - x[last - 1];
+            s[last].b = s[last - 1].b + (2.0 * s[last - 1].c + 3.0 * s[last - 1].d * h) * h;
+            s[last].d = 0.0;
+        }
+
+        static constexpr double value(const Segment& s, double dx) {return s.a + dx * (s.b + dx * (s.c + dx * s.d));}
+        static constexpr double firstDerivative(const Segment& s, double dx) {return s.b + dx * (2.0 * s.c + 3.0 * s.d * dx);}
+        static constexpr double secondDerivative(const Segment& s, double dx) {return 2.0 * s.c + 6.0 * s.d * dx;}
+    };
+}
+
+constexpr int DynamicKnots = -1;
+
+// Curve with the interpolation scheme as a template policy instead of virtual kernels, so that evaluation
+// inlines into the caller. A compile-time knot count N keeps the knots and segments in std::array (on the
+// stack for small curves, and usable in constant expressions); DynamicKnots stores them in std::vector.
+template <typename Policy, int N = DynamicKnots>
+class BasicCurve
+{
+    static_assert(N == DynamicKnots || N >= 2, "A curve needs at least two knots.");
+
+    public:
+        using Segment = typename Policy::Segment;
+
+        template <int M = N, typename = typename std::enable_if<M != DynamicKnots>::type>
+        constexpr BasicCurve(const std::array<double, N>& x, const std::array<double, N>& y): knots_{}, segments_{}
+        {
+            classSetter(x.data(), y.data(), N);
+        }
+
+        // Braced lists, e.g. BasicCurve<CurvePolicy::Linear, 3> curve({0.0, 1.0, 2.0}, {1.0, 2.0, 4.0}).
+        template <int M = N, typename = typename std::enable_if<M != DynamicKnots>::type>
+        constexpr BasicCurve(const double (&x)[M], const double (&y)[M]): knots_{}, segments_{}
+        {
+            classSetter(x, y, N);
+        }
+
+        BasicCurve(const std::vector<double>& x, const std::vector<double>& y): knots_{}, segments_{}
+        {
+            if (x.size() != y.size() || (N != DynamicKnots && static_cast<int>(x.size()) != N))
+                throw MathErrorRegistry::CurveInterpolation::MismatchVectorSizeError();
+            if constexpr (N == DynamicKnots) {knots_.resize(x.size()); segments_.resize(x.size());}
+            classSetter(x.data(), y.data(), x.size());
+        }
+
+        constexpr double evaluate(double x) const 
+        {
+            int i = getCheckedIndex(x);
+            return Policy::value(segments_[i], x - knots_[i]);
+        }
+        constexpr double evaluateFirstDerivative(double x) const 
+        {
+            int i = getCheckedIndex(x);
+            return Policy::firstDerivative(segments_[i], x - knots_[i]);
+        }
+        constexpr double evaluateSecondDerivative(double x) const 
+        {
+            int i = getCheckedIndex(x);
+            return Policy::secondDerivative(segments_[i], x - knots_[i]);
+        }
+
+        // Batched evaluation with the CurveInterpolation conventions: out is resized to x.size() and
+        // out-of-range points are set to NAN and reported by a false return value.
+        bool evaluate(const std::vector<double>& x, std::vector<double>& out) const
+        {
+            out.resize(x.size());
+            bool inRange = true;
+            for (std::size_t k = 0; k < x.size(); ++k) {
+                if (!isInRange(x[k])) {out[k] = NAN; inRange = false; continue;}
+                int i = findIndex(x[k]);
+                out[k] = Policy::value(segments_[i], x[k] - knots_[i]);
+            }
+            return inRange;
+        }
+
+        constexpr int getNumberKnots() const {return static_cast<int>(knots_.size());}
+        constexpr double getLowerBoundX() const {return knots_[0];}
+        constexpr double getUpperBoundX() const {return knots_[knots_.size() - 1];}
+
+        // Segment i covers [x_i, x_{i+1}), the last knot being its own segment. x must be in range.
+        constexpr int findIndex(double x) const
+        {
+            int low = 0, high = getNumberKnots() - 1;
+            if (x >= knots_[high]) return high;
+            while (high - low > 1) {
+                int middle = (low + high) / 2;
+                if (knots_[middle] <= x) low = middle; else high = middle;
+            }
+            return low;
+        }
+
+    private:
+        template <typename T>
+        using Storage = typename std::conditional<N == DynamicKnots, std::vector<T>, std::array<T, (N == DynamicKnots ? 0 : N)>>::type;
+
+        constexpr void classSetter(const double* x, const double* y, int n)
+        {
+            if (n < 2) throw MathErrorRegistry::CurveInterpolation::WrongVectorSizeError();
+            for (int i = 0; i < n; ++i) {
+                if (i > 0 && !(x[i] > x[i - 1])) throw MathErrorRegistry::CurveInterpolation::UnsortedKnotsError();
+                knots_[i] = x[i];
+                segments_[i].a = y[i];
+            }
+            Policy::build(knots_.data(), segments_.data(), n);
+        }
+
+        constexpr bool isInRange(double x) const {return x >= getLowerBoundX() && x <= getUpperBoundX();}
+
+        constexpr int getCheckedIndex(double x) const
+        {
+            if (!isInRange(x)) throw MathErrorRegistry::CurveInterpolation::OutOfRangeCurveInterpolationError();
+            return findIndex(x);
+        }
+
+        Storage<double> knots_;
+        Storage<Segment> segments_;
+};
@@ -1,39 +1,106 @@
 #pragma once 
 #include <iostream>
 #include <map>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <Eigen/Dense>
 #include "errors.hpp"
+#include "basiccurve.hpp"
 
 class CurveInterpolation
 {
     public:
+        // Knot storage for array constructors. Eigen::Ref input is always copied: for a strided or differently 
+        // typed expression the Ref holds a temporary copy, which must not be kept. Eigen::Map input can be 
+        // OWNED, copied once, or BORROWED, kept as a pointer to the caller's memory (e.g. memory-mapped curve 
+        // data), which must outlive the curve.
+        enum class Storage {OWNED, BORROWED};
+
         CurveInterpolation(const std::map<double, double>& data); 
+        CurveInterpolation(const std::vector<double>& x, const std::vector<double>& y); 
+        CurveInterpolation(const Eigen::Ref<const Eigen::VectorXd>& x, const Eigen::Ref<const Eigen::VectorXd>& y); 
+        CurveInterpolation(const Eigen::Map<const Eigen::VectorXd>& x, const Eigen::Map<const Eigen::VectorXd>& y, const Storage& storage); 
         virtual ~CurveInterpolation(){};
 
+        // Knot lookup strategy. UNIFORM_GRID indexes directly with floor((x - x0)/h) and is selected at 
+        // construction when every knot is within a quarter step of a uniform grid. BUCKET_TABLE is an 
+        // opt-in interpolation-search index for non-uniform knots. Both seed a galloping search, so the 
+        // result is always the same as BINARY_SEARCH.
+        enum class LookupMethod {BINARY_SEARCH, UNIFORM_GRID, BUCKET_TABLE};
+        void setLookupMethod(const LookupMethod& method);
+        LookupMethod getLookupMethod() const;
+
         double evaluate(double x) const; 
         double evaluateFirstDerivative(double x) const; 
         double evaluateSecondDerivative(double x) const; 
 
+        // Batched evaluation: out is resized to x.size() (no allocation when its capacity is enough).
+        // Out-of-range points are set to NAN and reported by a false return value instead of throwing.
+        bool evaluate(const std::vector<double>& x, std::vector<double>& out) const;
+        bool evaluateFirstDerivative(const std::vector<double>& x, std::vector<double>& out) const;
+        bool evaluateSecondDerivative(const std::vector<double>& x, std::vector<double>& out) const;
+
         std::map<double, double> getInitialData() const; 
+        int getNumberKnots() const;
         double getLowerBoundX() const;
         double getUpperBoundX() const;
 
+        // Stateful evaluator that remembers the last interval and gallops from it, so that a sorted 
+        // (or nearly sorted) sequence of m queries costs O(n + m) instead of O(m log n). The cursor 
+        // keeps a reference to the curve and must not outlive it.
+        class Cursor
+        {
+            public:
+                Cursor(const CurveInterpolation& curve);
+                ~Cursor() = default;
+
+                double evaluate(double x);
+                double evaluateFirstDerivative(double x);
+                double evaluateSecondDerivative(double x);
+                bool evaluate(const std::vector<double>& x, std::vector<double>& out);
+                bool evaluateFirstDerivative(const std::vector<double>& x, std::vector<double>& out);
+                bool evaluateSecondDerivative(const std::vector<double>& x, std::vector<double>& out);
+
+                int getIndex() const;
+                void reset();
+
+            private:
+                const CurveInterpolation& curve_;
+                int index_;
+        };
+
+        Cursor getCursor() const;
+
     protected: 
-        virtual double _evaluate(double x) const = 0;
-        virtual double _evaluateFirstDerivative(double x) const = 0; 
-        virtual double _evaluateSecondDerivative(double x) const = 0; 
+        // Kernels evaluate n points whose interval index (as returned by findIndex) is already known.
+        virtual void _evaluate(const double* x, const int* index, double* out, int n) const = 0;
+        virtual void _evaluateFirstDerivative(const double* x, const int* index, double* out, int n) const = 0;
+        virtual void _evaluateSecondDerivative(const double* x, const int* index, double* out, int n) const = 0;
 
         int findIndex(double x) const;
+        int findIndex(double x, int hint) const;
         double getX(int i) const;
-        double getY(int i) const;
-        std::vector<double> getVectorX() const;
-        std::vector<double> getVectorY() const;
+        virtual double getY(int i) const = 0;
+        const double* getKnots() const;
 
     private:
-        void classSetter(const std::map<double, double>& data);
+        using Kernel = void (CurveInterpolation::*)(const double*, const int*, double*, int) const;
+        static constexpr int BATCH_BLOCK_SIZE = 256;
+
+        void classSetter(int n);
+        bool isInRange(double x) const;
+        double evaluatePoint(double x, Kernel kernel, int* hint = nullptr) const;
+        bool evaluateBatch(const std::vector<double>& x, std::vector<double>& out, Kernel kernel, int* hint = nullptr) const;
+        double getGridPosition(double x) const;
         std::vector<double> xVector_; 
-        std::vector<double> yVector_; 
+        const double* borrowedX_;
+        int numberKnots_;
         double lowerBoundX_;
         double upperBoundX_ ;
+        LookupMethod lookupMethod_;
+        double inverseStep_;
+        std::vector<int> buckets_;
         
 
 };
@@ -42,26 +109,124 @@ class LinearInterpolation final: public CurveInterpolation
 {
     public: 
         LinearInterpolation(const std::map<double, double>& data);
+        LinearInterpolation(const std::vector<double>& x, const std::vector<double>& y);
+        LinearInterpolation(const Eigen::Ref<const Eigen::VectorXd>& x, const Eigen::Ref<const Eigen::VectorXd>& y);
+        LinearInterpolation(const Eigen::Map<const Eigen::VectorXd>& x, const Eigen::Map<const Eigen::VectorXd>& y, const Storage& storage);
         ~LinearInterpolation() = default;
     
     protected: 
-        double _evaluate(double x) const override;
-        double _evaluateFirstDerivative(double x) const override; 
-        double _evaluateSecondDerivative(double x) const override; 
+        void _evaluate(const double* x, const int* index, double* out, int n) const override;
+        void _evaluateFirstDerivative(const double* x, const int* index, double* out, int n) const override;
+        void _evaluateSecondDerivative(const double* x, const int* index, double* out, int n) const override;
+        double getY(int i) const override;
+
+    private:
+        void classSetter();
+        const double* getValues() const;
+        std::vector<double> yVector_, slopes_;
+        const double* borrowedY_;
 };
 
-class CubicSpline final: public CurveInterpolation
+// Common base of the piecewise cubic engines, which differ only in how the knot slopes are chosen. 
+class PiecewiseCubicInterpolation: public CurveInterpolation
+{
+    public: 
+        virtual ~PiecewiseCubicInterpolation() = default;
+
+    protected: 
+        PiecewiseCubicInterpolation(const std::map<double, double>& data);
+        PiecewiseCubicInterpolation(const std::vector<double>& x, const std::vector<double>& y);
+        PiecewiseCubicInterpolation(const Eigen::Ref<const Eigen::VectorXd>& x, const Eigen::Ref<const Eigen::VectorXd>& y);
+        PiecewiseCubicInterpolation(const Eigen::Map<const Eigen::VectorXd>& x, const Eigen::Map<const Eigen::VectorXd>& y, const Storage& storage);
+
+        void _evaluate(const double* x, const int* index, double* out, int n) const override;
+        void _evaluateFirstDerivative(const double* x, const int* index, double* out, int n) const override;
+        void _evaluateSecondDerivative(const double* x, const int* index, double* out, int n) const override;
+        double getY(int i) const override;
+
+        // Packed Horner coefficients of CurvePolicy::Cubic, the knots staying in the base class lookup array.
+        using Segment = CurvePolicy::Cubic::Segment;
+        // Hermite coefficients from one slope per knot, the values being already in the a coefficients.
+        void setHermiteSlopes(const std::vector<double>& slopes);
+        std::vector<Segment> segments_;
+
+    private:
+        void classSetter(const double* y);
+};
+
+class CubicSpline final: public PiecewiseCubicInterpolation
 {
     public: 
         CubicSpline(const std::map<double, double>& data);
+        CubicSpline(const std::vector<double>& x, const std::vector<double>& y);
+        CubicSpline(const Eigen::Ref<const Eigen::VectorXd>& x, const Eigen::Ref<const Eigen::VectorXd>& y);
+        CubicSpline(const Eigen::Map<const Eigen::VectorXd>& x, const Eigen::Map<const Eigen::VectorXd>& y, const Storage& storage);
         ~CubicSpline() = default;
-    protected: 
-        double _evaluate(double x) const override;
-        double _evaluateFirstDerivative(double x) const override; 
-        double _evaluateSecondDerivative(double x) const override; 
+
+        // Change knot values in place, the knots being fixed. The tridiagonal factorization is computed on 
+        // the first update and reused, so an update is one forward/back substitution with no allocation.
+        void updateValue(int index, double y);
+        void updateValues(const std::vector<double>& y);
+
+        // Sensitivities d spline(x_j) / d y_i of the values at x to every knot value, as a dense matrix with 
+        // one row per point. The coefficients being linear in y, a single factorization serves all knots. 
+        // Rows of out-of-range points are set to NAN and reported by a false return value.
+        bool evaluateJacobian(const std::vector<double>& x, Eigen::MatrixXd& jacobian) const;
     private:
         void classSetter();
-        std::vector<double> a_, b_, c_, d_, x_;
+        struct Factorization {std::vector<double> inverseH, inverseL, mu;};
+        void factorize(Factorization& factorization) const;
+        void solve(const Factorization& factorization);
+        Factorization factorization_;
     
 };
 
+// Fritsch-Carlson monotone cubic: no overshoot, the interpolant is monotone wherever the data are.
+class MonotoneCubicSpline final: public PiecewiseCubicInterpolation
+{
+    public: 
+        MonotoneCubicSpline(const std::map<double, double>& data);
+        MonotoneCubicSpline(const std::vector<double>& x, const std::vector<double>& y);
+        MonotoneCubicSpline(const Eigen::Ref<const Eigen::VectorXd>& x, const Eigen::Ref<const Eigen::VectorXd>& y);
+        MonotoneCubicSpline(const Eigen::Map<const Eigen::VectorXd>& x, const Eigen::Map<const Eigen::VectorXd>& y, const Storage& storage);
+        ~MonotoneCubicSpline() = default;
+    private:
+        void classSetter();
+};
+
+// Akima spline: local slopes, so an outlier only moves the two neighbouring segments. Linear data are 
+// reproduced exactly.
+class AkimaSpline final: public PiecewiseCubicInterpolation
+{
+    public: 
+        AkimaSpline(const std::map<double, double>& data);
+        AkimaSpline(const std::vector<double>& x, const std::vector<double>& y);
+        AkimaSpline(const Eigen::Ref<const Eigen::VectorXd>& x, const Eigen::Ref<const Eigen::VectorXd>& y);
+        AkimaSpline(const Eigen::Map<const Eigen::VectorXd>& x, const Eigen::Map<const Eigen::VectorXd>& y, const Storage& storage);
+        ~AkimaSpline() = default;
+    private:
+        void classSetter();
+};
+
+// Linear interpolation of log(y), e.g. of discount factors (piecewise constant forward rates). The 
+// values must be positive. y is always copied (and stored as log(y)), so Storage::BORROWED only borrows x.
+class LogLinearInterpolation final: public CurveInterpolation
+{
+    public: 
+        LogLinearInterpolation(const std::map<double, double>& data);
+        LogLinearInterpolation(const std::vector<double>& x, const std::vector<double>& y);
+        LogLinearInterpolation(const Eigen::Ref<const Eigen::VectorXd>& x, const Eigen::Ref<const Eigen::VectorXd>& y);
+        LogLinearInterpolation(const Eigen::Map<const Eigen::VectorXd>& x, const Eigen::Map<const Eigen::VectorXd>& y, const Storage& storage);
+        ~LogLinearInterpolation() = default;
+    
+    protected: 
+        void _evaluate(const double* x, const int* index, double* out, int n) const override;
+        void _evaluateFirstDerivative(const double* x, const int* index, double* out, int n) const override;
+        void _evaluateSecondDerivative(const double* x, const int* index, double* out, int n) const override;
+        double getY(int i) const override;
+
+    private:
+        void classSetter();
+        std::vector<double> yVector_, logValues_, slopes_;
+};
+
@@ -29,6 +29,30 @@ namespace MathErrorRegistry
             protected: 
                 std::string getErrorMessage() const override; 
         };
+
+        class InvalidKnotIndexError final: public MathLibraryError
+        {
+            protected: 
+                std::string getErrorMessage() const override; 
+        };
+
+        class MismatchVectorSizeError final: public MathLibraryError
+        {
+            protected: 
+                std::string getErrorMessage() const override; 
+        };
+
+        class UnsortedKnotsError final: public MathLibraryError
+        {
+            protected: 
+                std::string getErrorMessage() const override; 
+        };
+
+        class NonPositiveValueError final: public MathLibraryError
+        {
+            protected: 
+                std::string getErrorMessage() const override; 
+        };
     };
 
     namespace Optim 
@@ -38,6 +62,18 @@ namespace MathErrorRegistry
             protected: 
                 std::string getErrorMessage() const override; 
         };
+
+        class InvalidBracketError final: public MathLibraryError
+        {
+            protected: 
+                std::string getErrorMessage() const override; 
+        };
+
+        class LineSearchError final: public MathLibraryError
+        {
+            protected: 
+                std::string getErrorMessage() const override; 
+        };
     };
 
     namespace Probability
@@ -88,4 +124,34 @@ namespace MathErrorRegistry
                 std::string getErrorMessage() const override; 
         };
     }
+
+    namespace FiniteDifference 
+    {
+        class MismatchOutputSizeError final: public MathLibraryError
+        {
+            protected: 
+                std::string getErrorMessage() const override; 
+        };
+
+        class ComplexStepFunctionError final: public MathLibraryError
+        {
+            protected: 
+                std::string getErrorMessage() const override; 
+        };
+    }
+
+    namespace Quadrature 
+    {
+        class InvalidLaguerreAlphaError final: public MathLibraryError
+        {
+            protected: 
+                std::string getErrorMessage() const override; 
+        };
+
+        class UnsupportedKronrodRuleError final: public MathLibraryError
+        {
+            protected: 
+                std::string getErrorMessage() const override; 
+        };
+    }
 };
\ No newline at end of file
@@ -0,0 +1,76 @@
+#pragma once
+#include <vector>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <complex>
+#include <functional>
+#include <Eigen/Dense>
+#include "errors.hpp"
+#include "threadpool.hpp"
+
+// Finite difference gradients and Jacobians. The perturbed points are split into one contiguous block of
+// coordinates per thread, each block with its own point and value buffers; the buffers are kept across calls,
+// so repeated differentiation at a fixed size does not allocate on the sequential path. With several threads
+// the function is called concurrently and must be thread-safe. One object must not be used by several
+// threads at once.
+class FiniteDifference
+{
+    public:
+        enum class Method {FORWARD, CENTRAL, COMPLEX_STEP};
+        using Function = std::function<double(const Eigen::Ref<const Eigen::VectorXd>& x)>;
+        using ComplexFunction = std::function<std::complex<double>(const Eigen::Ref<const Eigen::VectorXcd>& x)>;
+        using VectorFunction = std::function<void(const Eigen::Ref<const Eigen::VectorXd>& x, Eigen::Ref<Eigen::VectorXd> values)>;
+        using ComplexVectorFunction = std::function<void(const Eigen::Ref<const Eigen::VectorXcd>& x, Eigen::Ref<Eigen::VectorXcd> values)>;
+
+        // numberThreads = 1 runs in the calling thread, numberThreads <= 0 uses std::thread::hardware_concurrency().
+        explicit FiniteDifference(const Method& method = Method::CENTRAL, int numberThreads = 1);
+        ~FiniteDifference() = default;
+
+        void setMethod(const Method& method);
+        // Relative step: coordinate j moves by step * (1 + |x_j|). NAN restores the default of the method,
+        // about eps^(1/2) for forward, eps^(1/3) for central and 1e-20 for complex-step differences.
+        void setStep(double step);
+
+        Method getMethod() const;
+        double getStep() const;
+        int getNumberThreads() const;
+        // Function calls made by the last gradient or jacobian call.
+        int getNumberEvaluations() const;
+
+        // The complex-step method needs the ComplexFunction overloads; the other methods evaluate complex
+        // functions at real points and keep the real part. fx, when given, is the value at x (forward differences
+        // reuse it instead of evaluating it again).
+        void gradient(const Function& f, const Eigen::Ref<const Eigen::VectorXd>& x, Eigen::Ref<Eigen::VectorXd> gradient);
+        void gradient(const Function& f, const Eigen::Ref<const Eigen::VectorXd>& x, double fx, Eigen::Ref<Eigen::VectorXd> gradient);
+        void gradient(const ComplexFunction& f, const Eigen::Ref<const Eigen::VectorXd>& x, Eigen::Ref<Eigen::VectorXd> gradient);
+
+        // jacobian(i, j) = d f_i / d x_j; the number of function values is jacobian.rows().
+        void jacobian(const VectorFunction& f, const Eigen::Ref<const Eigen::VectorXd>& x, Eigen::Ref<Eigen::MatrixXd> jacobian);
+        void jacobian(const VectorFunction& f, const Eigen::Ref<const Eigen::VectorXd>& x, const Eigen::Ref<const Eigen::VectorXd>& fx, Eigen::Ref<Eigen::MatrixXd> jacobian);
+        void jacobian(const ComplexVectorFunction& f, const Eigen::Ref<const Eigen::VectorXd>& x, Eigen::Ref<Eigen::MatrixXd> jacobian);
+
+    private:
+        double getStepSize(double x) const;
+        int getNumberChunks(int n) const;
+        void setBuffers(int n, int m, bool complex);
+
+        // Runs task(chunk, begin, end) over contiguous blocks of [0, n), one per thread.
+        template<typename Task>
+        void run(int n, const Task& task)
+        {
+            int chunks = getNumberChunks(n);
+            if (chunks == 1) {task(0, 0, n); return;}
+            pool_->parallelFor(chunks, [&task, n, chunks](int c) {task(c, c * n / chunks, (c + 1) * n / chunks);});
+        }
+
+        Method method_;
+        double step_;
+        std::shared_ptr<ThreadPool> pool_;
+        int numberEvaluations_;
+
+        // One buffer per chunk: perturbed point, and function values above and below it.
+        std::vector<Eigen::VectorXd> points_, up_, down_;
+        std::vector<Eigen::VectorXcd> complexPoints_, complexValues_;
+        Eigen::VectorXd values_;
+};
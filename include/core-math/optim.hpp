@@ -4,7 +4,70 @@
 #include <chrono>
 #include <set>
 #include <iterator>
+#include <functional>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <atomic>
+#include <string>
+#include <ostream>
+#include <Eigen/Dense>
 #include "errors.hpp"
+#include "finitedifference.hpp"
+#include "loss.hpp"
+#include "threadpool.hpp"
+
+// Opt-in per-iteration trace of an Optimizer (see Optimizer::setTrace). Records go to a ring buffer that keeps 
+// the latest ones, allocated once at construction, and to an optional callback. A trace belongs to one 
+// optimizer at a time and is not thread-safe.
+class OptimizerTrace
+{
+    public: 
+        // LINE_SEARCH is an L-BFGS step, DAMPED and REJECTED an accepted and a rejected Levenberg-Marquardt step. 
+        // REJECTED also records a failed L-BFGS line search, which ends the optimization.
+        enum class Step {INITIAL, REFLECT, EXPAND, CONTRACT, SHRINK, LINE_SEARCH, DAMPED, REJECTED};
+
+        struct Record
+        {
+            int iteration; 
+            Step step; 
+            double bestValue; 
+            // Largest distance from the best vertex for a simplex, step length for the gradient methods.
+            double diameter; 
+            // Objective evaluations since the start, seconds spent in them during the iteration, and seconds 
+            // since the start of the optimization.
+            int numberEvaluations; 
+            double evaluationTime; 
+            double elapsedTime; 
+        };
+        using Callback = std::function<void(const Record& record)>;
+
+        explicit OptimizerTrace(std::size_t capacity = 1024, const Callback& callback = nullptr);
+        ~OptimizerTrace() = default; 
+
+        void record(const Record& record);
+        void clear();
+
+        // Kept records, oldest first.
+        std::vector<Record> getRecords() const; 
+        std::size_t getCapacity() const; 
+        std::size_t getSize() const; 
+        // Records overwritten since the last clear because the buffer was full.
+        std::size_t getNumberDropped() const; 
+        static std::string getStepName(const Step& step);
+
+        void writeCSV(std::ostream& out) const; 
+        void writeJSON(std::ostream& out) const; 
+
+    private: 
+        std::vector<Record> records_; 
+        std::size_t head_, size_, dropped_; 
+        Callback callback_; 
+};
 
 class Optimizer
 {
@@ -12,27 +75,65 @@ class Optimizer
         Optimizer(); 
         virtual ~Optimizer() = default; 
 
+        // Runs the optimization unless it already ran with the current settings (setters reset the flag). A 
+        // run stopped by the cancellation flag is kept while the flag stays set, so that its results can be 
+        // read, and runs again once the flag is cleared or removed.
         void optimize();
 
+        // False after a cancelled run.
         bool isOptimized() const; 
         double getToleranceThreshold() const; 
         int getMaximumIterations() const; 
         double getTimeTaken() const; 
         std::exception_ptr getError() const;
+        virtual int getNumberIterations() = 0; 
+        // Value the optimizer drives down, at the result: f for a minimizer, |f| for a root finder.
+        virtual double getObjectiveValue() = 0; 
 
         void setToleranceThreshold(double value); 
         void setMaximumIterations(int value); 
+        // Optional flag polled once per iteration: when it is set, the optimizer stops and keeps its current 
+        // best point. The flag must outlive the optimization.
+        void setCancellationFlag(const std::atomic<bool>* flag); 
+        // Optional trace receiving one record per iteration; nullptr (the default) disables tracing, which then 
+        // costs one pointer test per iteration and per evaluation. The trace must outlive the optimization.
+        void setTrace(OptimizerTrace* trace); 
+        OptimizerTrace* getTrace() const; 
 
     protected: 
         void setOptimized(bool value);
+        bool isCancelled() const; 
+        bool isTraced() const {return trace_ != nullptr;}
+        // Times an objective call when tracing, and calls it directly otherwise.
+        template <typename F>
+        auto timeEvaluation(F&& evaluate) -> decltype(evaluate())
+        {
+            if (!trace_) return evaluate();
+            auto start = std::chrono::high_resolution_clock::now();
+            if constexpr (std::is_void<decltype(evaluate())>::value) {
+                evaluate();
+                addEvaluationTime(start);
+            } else {
+                auto value = evaluate();
+                addEvaluationTime(start);
+                return value;
+            }
+        }
+        void addEvaluationTime(const std::chrono::high_resolution_clock::time_point& start);
+        void traceIteration(int iteration, const OptimizerTrace::Step& step, double bestValue, double diameter, int numberEvaluations);
         virtual void _optimize() = 0;
     
     private: 
         bool optimized_;
+        bool interrupted_;
         double toleranceThreshold_; 
         int maximumIterations_; 
         double timeTaken_; 
         std::exception_ptr optimizeError;
+        const std::atomic<bool>* cancellationFlag_; 
+        OptimizerTrace* trace_; 
+        std::chrono::high_resolution_clock::time_point startTime_; 
+        double evaluationTime_; 
 };
 
 class NewtonRaphson final: public Optimizer
@@ -43,7 +144,8 @@ class NewtonRaphson final: public Optimizer
 
         double getResult();
         double getFunctionResult();
-        int getNumberIterations(); 
+        int getNumberIterations() override; 
+        double getObjectiveValue() override; 
         double getStartValue() const; 
         double evaluateFunction(double value) const; 
         double evaluateFunctionDerivative(double value) const; 
@@ -55,8 +157,8 @@ class NewtonRaphson final: public Optimizer
     
     private:
         double x0_; 
-        const std::function<double(double)>& f_; 
-        const std::function<double(double)>& fDeriv_;
+        std::function<double(double)> f_; 
+        std::function<double(double)> fDeriv_;
         double result_;
         double fResult_; 
         int numberIterations_; 
@@ -64,10 +166,156 @@ class NewtonRaphson final: public Optimizer
 };
 
 
+// Root finders working inside a bracket [a, b] over which f changes sign, which they never leave. A bracket 
+// without a sign change is reported as InvalidBracketError through getError(). The evaluation count 
+// includes the calls to the derivatives.
+class BracketedRootFinder: public Optimizer
+{
+    public: 
+        virtual ~BracketedRootFinder() = default; 
+
+        double getResult();
+        double getFunctionResult();
+        int getNumberIterations() override; 
+        double getObjectiveValue() override; 
+        int getNumberEvaluations(); 
+        double getLowerBound() const; 
+        double getUpperBound() const; 
+
+        void setBracket(double a, double b);
+
+    protected: 
+        BracketedRootFinder(double a, double b, const std::function<double(double)>& f);
+
+        double evaluateFunction(double x); 
+        // Checks the bracket and returns f(a) and f(b) through fa and fb.
+        void checkBracket(double& fa, double& fb); 
+        void setRoot(double x, double fX); 
+        void countEvaluation(); 
+        // Newton-type iteration x -= step(x, f(x)), falling back to bisection whenever the step leaves the 
+        // current bracket, is not finite, or does not at least halve compared with the step before last.
+        void solveSafeguarded(double x0, const std::function<double(double, double)>& step);
+
+        int numberIterations_; 
+
+    private: 
+        double a_; 
+        double b_; 
+        std::function<double(double)> f_; 
+        double result_; 
+        double fResult_; 
+        int numberEvaluations_; 
+};
+
+// Brent's method: inverse quadratic interpolation and secant steps, with bisection as a fallback. 
+// Derivative-free, and never slower than bisection by more than a constant factor.
+class Brent final: public BracketedRootFinder
+{
+    public: 
+        Brent(double a, double b, const std::function<double(double)>& f);
+        ~Brent() = default; 
+
+    protected: 
+        void _optimize() override;
+};
+
+// Newton-Raphson safeguarded by bisection: no failure on flat derivatives or on steps out of the bracket.
+class NewtonBisection final: public BracketedRootFinder
+{
+    public: 
+        NewtonBisection(double a, double b, const std::function<double(double)>& f, const std::function<double(double)>& fDeriv);
+        ~NewtonBisection() = default; 
+
+        // Start value of the iteration, the middle of the bracket by default.
+        void setStartValue(double x0);
+        double getStartValue() const; 
+
+    protected: 
+        void _optimize() override;
+
+    private: 
+        std::function<double(double)> fDeriv_; 
+        double x0_; 
+};
+
+// Halley's method (cubic convergence from f, f' and f''), safeguarded by bisection within the bracket.
+class Halley final: public BracketedRootFinder
+{
+    public: 
+        Halley(double a, double b, const std::function<double(double)>& f, const std::function<double(double)>& fDeriv, const std::function<double(double)>& fSecondDeriv);
+        ~Halley() = default; 
+
+        // Start value of the iteration, the middle of the bracket by default.
+        void setStartValue(double x0);
+        double getStartValue() const; 
+
+    protected: 
+        void _optimize() override;
+
+    private: 
+        std::function<double(double)> fDeriv_; 
+        std::function<double(double)> fSecondDeriv_; 
+        double x0_; 
+};
+
+// Bounded least-recently-used map from points to objective values, keyed on the exact bits of the point. 
+// Points, values, the recency list and an open-addressing hash table live in flat buffers sized by reset, so 
+// lookups and insertions do not allocate.
+class EvaluationCache
+{
+    public: 
+        EvaluationCache(int dimension = 0, std::size_t capacity = 0);
+        ~EvaluationCache() = default; 
+
+        // Empties the cache and sizes it; a capacity of 0 disables it.
+        void reset(int dimension, std::size_t capacity);
+        void clear();
+        void resetCounters();
+
+        // On a hit, sets value and marks the point as the most recently used.
+        bool find(const double* x, double& value);
+        // Stores a point that is not in the cache, evicting the least recently used one when full.
+        void insert(const double* x, double value);
+
+        int getDimension() const; 
+        std::size_t getCapacity() const; 
+        std::size_t getSize() const; 
+        long long getHits() const; 
+        long long getMisses() const; 
+
+    private: 
+        std::size_t hash(const double* x) const; 
+        bool isEqual(int slot, const double* x) const; 
+        int findPosition(const double* x, std::size_t h) const; 
+        void erasePosition(std::size_t position); 
+        void unlink(int slot); 
+        void pushFront(int slot); 
+
+        int n_; 
+        std::size_t capacity_, size_, mask_; 
+        std::vector<double> points_, values_; 
+        std::vector<std::size_t> hashes_; 
+        // Recency list over the slots, most recent at head_; table_ holds slots, -1 when empty.
+        std::vector<int> previous_, next_, table_; 
+        int head_, tail_; 
+        long long hits_, misses_; 
+};
+
+// Objective signatures accepted by NelderMead, from the cheapest to call to the legacy one: 
+// double(const double* x, int n), double(Eigen::Ref<const Eigen::VectorXd> x), and double(std::vector<double> x) 
+// (which copies the point on every call unless it is taken by const reference).
+template <typename F>
+constexpr bool isNelderMeadObjective = 
+    std::is_invocable_r<double, F&, const double*, int>::value || 
+    std::is_invocable_r<double, F&, Eigen::Ref<const Eigen::VectorXd>>::value || 
+    std::is_invocable_r<double, F&, const std::vector<double>&>::value;
+
 class NelderMead final: public Optimizer
 {
     public: 
-        NelderMead(const std::vector<double>& x0,const std::function<double(std::vector<double>)>& f);
+        // The callable is stored as is and reached through a function pointer, without std::function.
+        template <typename F, typename = typename std::enable_if<isNelderMeadObjective<typename std::decay<F>::type>>::type>
+        NelderMead(const std::vector<double>& x0, F&& f): NelderMead(x0, makeObjective(std::forward<F>(f))){};
         ~NelderMead() = default ;  
 
         enum class InitSimplexMethod {BASIC, SCALED, SYMMETRIC};
@@ -79,6 +327,17 @@ class NelderMead final: public Optimizer
         void setExpansionParam(double beta);
         void setContractionParam(double gamma);
         void setShrinkParam(double delta);
+        // Memoizes up to capacity objective values of exact points (0, the default, disables the cache). The 
+        // entries are kept across optimizations of this object, the hit and miss counters are per optimization.
+        void setCacheCapacity(std::size_t capacity);
+        // Evaluates the independent points of the initial simplex, of shrink steps and of the parallel directions 
+        // on a thread pool (1, the default, runs in the calling thread; <= 0 uses every core). The objective 
+        // must then be safe to call concurrently.
+        void setNumberThreads(int numberThreads);
+        // Parallel-direction variant (Lee and Wiswall): the p worst vertices are reflected, expanded or contracted 
+        // at once against the centroid of the n + 1 - p others, and the simplex shrinks only when none of them 
+        // improves. p = 1, the default, is the classic method; p is capped at n.
+        void setNumberDirections(int p);
 
         std::vector<double> getStartValues() const;
         InitSimplexMethod getInitSimplexMethod() const;
@@ -87,17 +346,49 @@ class NelderMead final: public Optimizer
         double getExpansionParam() const;
         double getContractionParam() const;
         double getShrinkParam() const;
+        std::size_t getCacheCapacity() const;
+        int getNumberThreads() const;
+        int getNumberDirections() const;
         std::vector<double> getResult();
         double getFunctionResult();
-        int getNumberIterations(); 
+        int getNumberIterations() override; 
+        double getObjectiveValue() override; 
+        // Objective calls, cache hits excluded.
+        int getNumberEvaluations(); 
+        long long getCacheHits(); 
+        long long getCacheMisses(); 
     
     protected: 
         void _optimize() override;
 
     private: 
+        // Type-erased objective: the thunk casts the callable back to its type and adapts the point to its signature.
+        struct Objective
+        {
+            double (*thunk)(void* callable, const std::vector<double>& x);
+            std::shared_ptr<void> callable;
+        };
+
+        template <typename F>
+        static Objective makeObjective(F&& f)
+        {
+            using Callable = typename std::decay<F>::type;
+            Objective objective;
+            objective.callable = std::make_shared<Callable>(std::forward<F>(f));
+            objective.thunk = [](void* callable, const std::vector<double>& x) -> double {
+                Callable& g = *static_cast<Callable*>(callable);
+                if constexpr (std::is_invocable_r<double, Callable&, const double*, int>::value) return g(x.data(), static_cast<int>(x.size()));
+                else if constexpr (std::is_invocable_r<double, Callable&, Eigen::Ref<const Eigen::VectorXd>>::value) return g(Eigen::Map<const Eigen::VectorXd>(x.data(), x.size()));
+                else return g(x);
+            };
+            return objective;
+        }
+
+        NelderMead(const std::vector<double>& x0, Objective objective);
+
         std::vector<double> x0_; 
         const int n_;
-        const std::function<double(std::vector<double>)> f_;
+        Objective f_;
         double epsilon_; 
         double alpha_; 
         double beta_; 
@@ -105,40 +396,243 @@ class NelderMead final: public Optimizer
         double delta_;
         InitSimplexMethod initSimplexMethod_;
 
-        struct Vertex
-        {
-            Vertex(const std::vector<double>& points, double value); 
-            ~Vertex() = default;
-            std::vector<double> points_; 
-            double value_; 
-        }; 
+        // The simplex lives in one (n + 1) x n row-major buffer. Vertices never move: order_ ranks the rows 
+        // from best to worst, and a replaced vertex is re-ranked by insertion. sum_ holds the sum of all the 
+        // vertices, so that the centroid of the n best ones is (sum_ - worst) / n.
+        std::vector<double> vertices_; 
+        std::vector<double> values_; 
+        std::vector<int> order_; 
+        std::vector<double> sum_; 
+        std::vector<double> centroid_, reflection_, trial_, point_; 
+        int numberEvaluations_; 
+        std::size_t cacheCapacity_; 
+        EvaluationCache cache_; 
+        int numberDirections_; 
+        std::shared_ptr<ThreadPool> pool_; 
+        // Points evaluated together (initial simplex, shrink, parallel directions), with their values, the 
+        // indices missing from the cache, and the second trial slot of each direction (-1 when none).
+        std::vector<std::vector<double>> batch_; 
+        std::vector<double> batchValues_; 
+        std::vector<int> pending_, secondSlots_; 
 
-        struct Simplex
-        {
-            Simplex(const std::vector<Vertex>& vertices); 
-            ~Simplex() = default;
-            
-            std::vector<Vertex> vertices_; 
+        double getSymAlpha() const;
+        double* getRow(int i);
+        double evaluateVertex(const std::vector<double>& x);
+        void setInitialSimplex(); 
+        void setCentroid(int numberMoving); 
+        void setSum(); 
+        void setTrial(std::vector<double>& x, const double* from, double coefficient);
+        void replaceWorst(const std::vector<double>& x, double value); 
+        void shrink(); 
+        bool isBatched() const;
+        void evaluateBatch(int first, int count);
+        // One iteration of the classic method, and of the parallel-direction variant with p directions.
+        OptimizerTrace::Step stepSimplex();
+        OptimizerTrace::Step stepDirections(int p);
+        // Largest distance from the best vertex to the others.
+        double getDiameter() const;
+        bool checkConvergence() const;
 
-            void sortVertices();
-            void setVertex(const Vertex& vertex_, int i);
-            Vertex getBest() const;
-            Vertex getWorst() const;
-            Vertex getSecondWorst() const;
+        std::vector<double> result_;
+        double fResult_; 
+        int numberIterations_; 
+};
 
-        };
+// Limited-memory BFGS with a backtracking (Armijo) line search. The gradient is user-supplied, or computed by 
+// FiniteDifference (central differences by default). All work vectors are sized once per optimization, so the iterations do not 
+// allocate (as long as the callbacks do not). A line search that finds no decrease, e.g. with a wrong or too noisy gradient, 
+// fails the optimization with LineSearchError.
+class LBFGS final: public Optimizer
+{
+    public: 
+        using Function = FiniteDifference::Function;
+        using Gradient = std::function<void(const Eigen::Ref<const Eigen::VectorXd>& x, Eigen::Ref<Eigen::VectorXd> gradient)>;
 
-        double getSymAlpha() const;
-        Vertex getVertex(std::vector<double> x_input) const;
-        Simplex getInitialSimplex() const; 
-        Vertex getCentroid(const Simplex& simplex_) const;
-        Vertex getReflection(const Vertex& centroid, const Vertex& worst) const; 
-        Vertex getExpansion(const Vertex& centroid, const Vertex& reflection) const; 
-        Vertex getContraction(const Vertex& centroid, const Vertex& worst) const; 
-        Simplex getShrink(const Simplex& simplex_) const; 
-        bool checkConvergence(const Simplex& simplex_) const;
+        LBFGS(const Eigen::VectorXd& x0, const Function& f);
+        LBFGS(const Eigen::VectorXd& x0, const Function& f, const Gradient& gradient);
+        ~LBFGS() = default; 
+
+        void setStartValues(const Eigen::VectorXd& x0);
+        // Number of correction pairs kept to approximate the inverse Hessian.
+        void setHistorySize(int m);
+        // Method, step and threads of the gradient when none is supplied.
+        void setFiniteDifference(const FiniteDifference& differences);
+
+        Eigen::VectorXd getStartValues() const; 
+        int getHistorySize() const; 
+        const FiniteDifference& getFiniteDifference() const; 
+        Eigen::VectorXd getResult();
+        Eigen::VectorXd getGradientResult();
+        double getFunctionResult();
+        int getNumberIterations() override; 
+        double getObjectiveValue() override; 
+        int getNumberEvaluations(); 
+
+    protected: 
+        void _optimize() override;
+
+    private: 
+        double evaluateFunction(const Eigen::VectorXd& x); 
+        void evaluateGradient(const Eigen::VectorXd& x, double fx, Eigen::VectorXd& gradient); 
+        void setDirection(); 
+
+        Eigen::VectorXd x0_; 
+        Function f_; 
+        Gradient gradient_; 
+        int historySize_; 
+        FiniteDifference differences_; 
+
+        // Correction pairs s = x_k+1 - x_k and y = g_k+1 - g_k in circular column buffers, newest at head_.
+        Eigen::MatrixXd s_, y_; 
+        Eigen::VectorXd rho_, alpha_; 
+        int head_, count_; 
+        Eigen::VectorXd x_, g_, direction_, xNew_, gNew_; 
+
+        double fResult_; 
+        int numberIterations_; 
+        int numberEvaluations_; 
+};
+
+// Levenberg-Marquardt least squares: minimizes 0.5 |r(x)|^2 with r = model(x) - trueValues, the residual 
+// convention of EstimatorLoss. For a plain residual function, pass zero true values. The Jacobian of the 
+// model is user-supplied or computed by FiniteDifference (forward differences by default); work matrices are 
+// sized once per optimization.
+class LevenbergMarquardt final: public Optimizer
+{
+    public: 
+        using Model = FiniteDifference::VectorFunction;
+        using Jacobian = std::function<void(const Eigen::Ref<const Eigen::VectorXd>& x, Eigen::Ref<Eigen::MatrixXd> jacobian)>;
+
+        LevenbergMarquardt(const Eigen::VectorXd& x0, const Model& model, const Eigen::VectorXd& trueValues);
+        LevenbergMarquardt(const Eigen::VectorXd& x0, const Model& model, const Eigen::VectorXd& trueValues, const Jacobian& jacobian);
+        ~LevenbergMarquardt() = default; 
+
+        void setStartValues(const Eigen::VectorXd& x0);
+        // Method, step and threads of the Jacobian when none is supplied.
+        void setFiniteDifference(const FiniteDifference& differences);
+
+        Eigen::VectorXd getStartValues() const; 
+        const FiniteDifference& getFiniteDifference() const; 
+        Eigen::VectorXd getResult();
+        // Model estimates against the true values at the result, as OrdinaryLeastSquare::getResidualsObject.
+        EstimatorLoss getResidualsObject();
+        double getFunctionResult();
+        int getNumberIterations() override; 
+        double getObjectiveValue() override; 
+        int getNumberEvaluations(); 
+
+    protected: 
+        void _optimize() override;
+
+    private: 
+        void evaluateResiduals(const Eigen::VectorXd& x, Eigen::VectorXd& estimates, Eigen::VectorXd& residuals); 
+        void evaluateJacobian(); 
+
+        Eigen::VectorXd x0_; 
+        Model model_; 
+        Eigen::VectorXd trueValues_; 
+        Jacobian jacobian_; 
+        FiniteDifference differences_; 
+
+        Eigen::VectorXd x_, xNew_, estimates_, estimatesNew_, residuals_, residualsNew_; 
+        Eigen::VectorXd gradient_, delta_; 
+        Eigen::MatrixXd J_, JtJ_, A_; 
+        Eigen::LLT<Eigen::MatrixXd> llt_; 
 
-        std::vector<double> result_;
         double fResult_; 
         int numberIterations_; 
-};
\ No newline at end of file
+        int numberEvaluations_; 
+};
+
+// Newton-Raphson on many independent scalar equations at once. The callbacks evaluate f and f' on every 
+// lane in one call, so that they can be written as Eigen array expressions and vectorized. All lanes step 
+// in lock-step: a lane that converges or fails is masked out (its point is frozen) and its outcome is 
+// recorded as a status code instead of an exception, so one bad lane does not stop the others.
+class BatchNewtonRaphson final: public Optimizer
+{
+    public: 
+        using Function = std::function<void(const Eigen::Ref<const Eigen::ArrayXd>& x, Eigen::Ref<Eigen::ArrayXd> out)>;
+
+        BatchNewtonRaphson(const Eigen::Ref<const Eigen::ArrayXd>& x0, const Function& f, const Function& fDeriv);
+        ~BatchNewtonRaphson() = default; 
+
+        enum class Status {CONVERGED, MAXIMUM_ITERATIONS, DERIVATIVE_ZERO, NOT_FINITE};
+
+        // Roots per lane, NAN for the lanes that failed (DERIVATIVE_ZERO or NOT_FINITE).
+        const Eigen::ArrayXd& getResults();
+        const Eigen::ArrayXd& getFunctionResults();
+        const std::vector<Status>& getStatuses();
+        const Eigen::ArrayXi& getLaneIterations();
+        // Lock-step iterations, i.e. until the last lane finished.
+        int getNumberIterations() override; 
+        // Largest |f| over the lanes that did not fail.
+        double getObjectiveValue() override; 
+        int getNumberLanes() const; 
+        const Eigen::ArrayXd& getStartValues() const; 
+
+        void setStartValues(const Eigen::Ref<const Eigen::ArrayXd>& x0);
+
+    protected: 
+        void _optimize() override;
+    
+    private:
+        Eigen::ArrayXd x0_; 
+        Function f_; 
+        Function fDeriv_;
+        Eigen::ArrayXd result_, fResult_, fDerivResult_; 
+        Eigen::ArrayXi laneIterations_; 
+        std::vector<Status> statuses_; 
+        int numberIterations_; 
+};
+
+// Runs independent optimizations on a work-stealing thread pool: either a list of problems, or copies of one 
+// problem from many starting points (multi-start). The objectives of the copies are shared and must be safe 
+// to call concurrently; the copies are not traced.
+class BatchOptimizer
+{
+    public: 
+        BatchOptimizer(const std::vector<std::shared_ptr<Optimizer>>& problems, int numberThreads = 0);
+        BatchOptimizer(const NelderMead& problem, const std::vector<std::vector<double>>& startValues, int numberThreads = 0);
+        BatchOptimizer(const NewtonRaphson& problem, const std::vector<double>& startValues, int numberThreads = 0);
+        ~BatchOptimizer() = default;
+
+        // CANCELLED problems were skipped or stopped early because another one reached the target value.
+        enum class Status {COMPLETED, FAILED, CANCELLED};
+
+        struct Report
+        {
+            Status status; 
+            int numberIterations; 
+            double objectiveValue; 
+            double timeTaken; 
+            std::exception_ptr error; 
+        };
+
+        void optimize();
+
+        // Once a problem reaches an objective value at or below the target, the others are cancelled.
+        void setTargetValue(double target);
+        void setNumberThreads(int numberThreads);
+
+        bool isOptimized() const; 
+        double getTargetValue() const;
+        int getNumberThreads() const;
+        int getNumberProblems() const;
+        double getTimeTaken() const;
+        std::shared_ptr<Optimizer> getProblem(int i) const;
+        const std::vector<Report>& getReports();
+        // Index of the completed problem with the lowest objective value, -1 if none completed.
+        int getBestIndex();
+
+    private: 
+        void run(int i);
+
+        std::vector<std::shared_ptr<Optimizer>> problems_; 
+        int numberThreads_; 
+        double targetValue_; 
+        bool optimized_; 
+        double timeTaken_; 
+        std::atomic<bool> cancelled_; 
+        std::unique_ptr<ThreadPool> pool_; 
+        std::vector<Report> reports_; 
+};
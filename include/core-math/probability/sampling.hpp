@@ -1,6 +1,8 @@
 #pragma once 
 #include <iostream>
 #include <random>
+#include <memory>
+#include <chrono>
 #include "distributions.hpp"
 #include <Eigen/Dense>
 
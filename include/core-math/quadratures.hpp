@@ -1,18 +1,58 @@
 #pragma once
 #include <iostream>
 #include <vector>
+#include <cmath>
+#include <limits>
+#include <algorithm>
 #include <functional>
+#include <memory>
+#include <mutex>
+#include <map>
+#include <tuple>
+#include <typeindex>
+#include <chrono>
 #include <Eigen/Dense>
+#include "errors.hpp"
+#include "threadpool.hpp"
+#include "quadraturetables.hpp"
+
+// Nodes and weights of a quadrature rule.
+struct QuadratureNodes
+{
+    std::vector<double> roots; 
+    std::vector<double> weights; 
+    // Weights of an embedded lower order rule on the same nodes (0 where it has no node), empty if there is none.
+    std::vector<double> embeddedWeights; 
+};
+
+// Process-wide, thread-safe table of quadrature nodes, keyed on the rule type, the number of points and the 
+// parameter of the rule. An entry is built on first use and then shared read-only by every instance.
+namespace QuadratureNodeCache
+{
+    std::shared_ptr<const QuadratureNodes> get(const std::type_index& rule, int points, double parameter, const std::function<QuadratureNodes()>& build);
+    std::size_t getSize();
+    void clear();
+}
 
 class GaussianQuadrature
 {
     public: 
+        // Integrands evaluated at all the nodes at once: values[i] = f(nodes[i]), or values(i, j) = f_j(nodes[i])
+        // for several integrands against the same rule.
+        using BatchFunction = std::function<void(const Eigen::Ref<const Eigen::VectorXd>& nodes, Eigen::Ref<Eigen::VectorXd> values)>;
+        using MatrixFunction = std::function<void(const Eigen::Ref<const Eigen::VectorXd>& nodes, Eigen::Ref<Eigen::MatrixXd> values)>;
+
         GaussianQuadrature(int points); 
         virtual ~GaussianQuadrature() = default;
         
 
         int getPoints() const;
         double integrate(const std::function<double(double)>& f);
+        // One call to f and a dot product with the weights; the node and value buffers are kept across calls.
+        double integrate(const BatchFunction& f);
+        // integrals[j] is the integral of f_j, the number of integrands being integrals.size().
+        void integrate(const MatrixFunction& f, Eigen::Ref<Eigen::VectorXd> integrals);
+        // Nodes and weights as used by integrate, after the change of variable of the rule if it has one.
         std::vector<double> getRoots();
         std::vector<double> getWeights();
         bool isComputed() const;
@@ -21,25 +61,184 @@ class GaussianQuadrature
         void compute(); 
 
     protected: 
-        void setWeigts(std::vector<double> weights); 
-        void setRoots(std::vector<double> roots); 
-        void setIsCompute(bool value);
-        virtual void _compute() = 0;
+        // Parameter of the rule (0 when it has none), part of the cache key.
+        virtual double getParameter() const;
+        // Nodes for getPoints() points: called once per process and key, the result is then shared.
+        virtual QuadratureNodes computeNodes() const = 0;
+
+        // Golub-Welsch in O(n^2): the nodes are the eigenvalues of the symmetric tridiagonal Jacobi matrix
+        // (offDiagonal[k] couples k and k + 1), found by implicit QL without eigenvectors, then polished by Newton
+        // steps on the three-term recurrence. The weights are the Christoffel numbers mass / sum_k p_k(x)^2 of the
+        // orthonormal polynomials, accurate relative to their size even when they are far below rounding of the
+        // largest one. mass is the integral of the weight function.
+        static QuadratureNodes computeGolubWelsch(const std::vector<double>& diagonal, const std::vector<double>& offDiagonal, double mass);
+
+        // Cached nodes of the rule, computed if needed.
+        const QuadratureNodes& getNodes();
+        // Change of variable x = shift + scale * root applied by integrate, the weights being multiplied by scale.
+        void setAffineMap(double shift, double scale);
+        double getShift() const;
+        double getScale() const;
+        // Values of f at the mapped nodes, in a buffer owned by the quadrature.
+        const Eigen::VectorXd& evaluateBatch(const BatchFunction& f);
 
     private:
+        // Nodes after the change of variable: the cached ones directly when there is none.
+        Eigen::Ref<const Eigen::VectorXd> getMappedRoots();
+
         int points_;
-        bool computed_;
-        std::vector<double> roots_;
-        std::vector<double> weights_;
+        double shift_;
+        double scale_;
+        std::shared_ptr<const QuadratureNodes> nodes_;
+        Eigen::VectorXd mappedRoots_;
+        Eigen::VectorXd values_;
+        Eigen::MatrixXd matrixValues_;
 };
 
+// Rules on [-1, 1], mapped to [lower, upper].
+class IntervalQuadrature: public GaussianQuadrature
+{
+    public: 
+        IntervalQuadrature(int points, double lower, double upper); 
+        virtual ~IntervalQuadrature() = default;
+
+        double getLower() const;
+        double getUpper() const;
+        void setInterval(double lower, double upper);
+
+    private:
+        double lower_;
+        double upper_;
+};
+
+// Integral of f(x) x^alpha exp(-x) over [0, infinity): the generalized rule for alpha != 0.
 class GaussLaguerreQuadrature final: public GaussianQuadrature
 {
     public: 
-        GaussLaguerreQuadrature(int points); 
+        GaussLaguerreQuadrature(int points, double alpha = 0.0); 
         ~GaussLaguerreQuadrature() = default;
+
+        double getAlpha() const;
     protected: 
-        void _compute() override;
+        double getParameter() const override;
+        // Tabulated sizes (QuadratureTables) are copied for alpha = 0, the others go through computeGolubWelsch.
+        QuadratureNodes computeNodes() const override;
+
+    private:
+        double alpha_;
+};
 
+// Integral of f(x) exp(-x^2) over the real line.
+class GaussHermiteQuadrature final: public GaussianQuadrature
+{
+    public: 
+        GaussHermiteQuadrature(int points); 
+        ~GaussHermiteQuadrature() = default;
+    protected: 
+        QuadratureNodes computeNodes() const override;
 };
 
+// Integral of f(x) over [lower, upper].
+class GaussLegendreQuadrature final: public IntervalQuadrature
+{
+    public: 
+        GaussLegendreQuadrature(int points, double lower = -1.0, double upper = 1.0); 
+        ~GaussLegendreQuadrature() = default;
+    protected: 
+        QuadratureNodes computeNodes() const override;
+};
+
+// Gauss-Kronrod pair on [lower, upper]: the 2n + 1 point Kronrod rule, with the n point Gauss rule embedded in its
+// nodes for the error estimate. getPoints() is the number of Gauss points, 7 (G7K15) or 10 (G10K21), whose
+// QUADPACK constants are tabulated.
+class GaussKronrodQuadrature final: public IntervalQuadrature
+{
+    public: 
+        GaussKronrodQuadrature(int points = 7, double lower = -1.0, double upper = 1.0); 
+        ~GaussKronrodQuadrature() = default;
+
+        using GaussianQuadrature::integrate;
+        // Kronrod estimate of the integral, with the QUADPACK error estimate: the Gauss-Kronrod difference scaled
+        // down by (200 |K - G| / resasc)^1.5, resasc measuring the variation of f, and bounded below by rounding.
+        double integrate(const std::function<double(double)>& f, double& error);
+        double integrate(const BatchFunction& f, double& error);
+        std::vector<double> getGaussWeights();
+    protected: 
+        QuadratureNodes computeNodes() const override;
+
+    private:
+        // Integral and error estimate from the values of f at the nodes.
+        double estimateIntegral(const double* values, double& error);
+};
+
+// Adaptive Gauss-Kronrod integration over [lower, upper] (QUADPACK qag): the subintervals are kept in a max-heap
+// on their error estimate, and the worst ones are bisected until the total error estimate is below
+// max(absoluteTolerance, relativeTolerance * |integral|) or maxSubintervals is reached. With several threads, the
+// numberThreads worst subintervals are bisected at once and their halves integrated concurrently: f must then be
+// thread-safe, and the refinement (so the result) depends on the number of threads. One object must not be used
+// by several threads at once.
+class AdaptiveQuadrature
+{
+    public: 
+        // numberThreads = 1 runs in the calling thread, numberThreads <= 0 uses std::thread::hardware_concurrency().
+        explicit AdaptiveQuadrature(double absoluteTolerance = 1e-10, double relativeTolerance = 1e-10, int numberThreads = 1); 
+        ~AdaptiveQuadrature() = default;
+
+        void setAbsoluteTolerance(double tolerance);
+        void setRelativeTolerance(double tolerance);
+        void setMaxSubintervals(int maxSubintervals);
+        // Gauss points of the Kronrod pair: 7 (G7K15, default) or 10 (G10K21).
+        void setRule(int gaussPoints);
+
+        double getAbsoluteTolerance() const;
+        double getRelativeTolerance() const;
+        int getMaxSubintervals() const;
+        int getRule() const;
+        int getNumberThreads() const;
+
+        double integrate(const std::function<double(double)>& f, double lower, double upper);
+        // Each subinterval is one call to f at all the nodes of the rule.
+        double integrate(const GaussianQuadrature::BatchFunction& f, double lower, double upper);
+
+        // Statistics of the last integrate call: error estimate, calls to f, final number of subintervals,
+        // wall time in seconds, and whether the tolerance was met.
+        double getError() const;
+        int getNumberEvaluations() const;
+        int getNumberSubintervals() const;
+        double getTimeTaken() const;
+        bool isConverged() const;
+
+    private:
+        struct Interval
+        {
+            double lower;
+            double upper;
+            double integral;
+            double error;
+            bool operator<(const Interval& other) const {return error < other.error;}
+        };
+
+        double getTolerance(double integral) const;
+        // Integrates f over intervals[j] for j in [0, n), on the pool when there is one.
+        template<typename Function>
+        void evaluate(const Function& f, std::vector<Interval>& intervals, int n);
+        template<typename Function>
+        double refine(const Function& f, double lower, double upper);
+
+        GaussKronrodQuadrature rule_;
+        double absoluteTolerance_;
+        double relativeTolerance_;
+        int maxSubintervals_;
+        std::shared_ptr<ThreadPool> pool_;
+
+        double error_;
+        int numberEvaluations_;
+        int numberSubintervals_;
+        double timeTaken_;
+        bool converged_;
+
+        // Kept across calls: heap of subintervals, and the bisected ones with their halves.
+        std::vector<Interval> heap_;
+        std::vector<Interval> bisected_;
+        std::vector<Interval> halves_;
+};
@@ -0,0 +1,255 @@
+#pragma once
+
+// Generated by scripts/gausslaguerre_tables.cpp, do not edit: Gauss-Laguerre nodes and weights (alpha = 0), 
+// computed in __float128 and rounded to double.
+namespace QuadratureTables
+{
+    struct Table
+    {
+        int points; 
+        const double* roots; 
+        const double* weights; 
+    };
+
+    inline constexpr double laguerreRoots8[8] = {
+        0.17027963230510099, 0.90370177679937991, 2.2510866298661307, 4.2667001702876588,
+        7.0459054023934655, 10.758516010180996, 15.740678641278004, 22.863131736889265};
+    inline constexpr double laguerreWeights8[8] = {
+        0.36918858934163751, 0.41878678081434295, 0.1757949866371718, 0.033343492261215649,
+        0.0027945362352256725, 9.0765087733582134e-05, 8.4857467162725313e-07, 1.0480011748715104e-09};
+
+    inline constexpr double laguerreRoots16[16] = {
+        0.087649410478927839, 0.46269632891508083, 1.1410577748312269, 2.1292836450983805,
+        3.4370866338932067, 5.0780186145497677, 7.0703385350482337, 9.4383143363919384,
+        12.214223368866159, 15.441527368781617, 19.180156856753136, 23.515905693991908,
+        28.578729742882139, 34.583398702286622, 41.940452647688332, 51.701160339543321};
+    inline constexpr double laguerreWeights16[16] = {
+        0.20615171495780099, 0.33105785495088419, 0.26579577764421414, 0.13629693429637754,
+        0.047328928694125222, 0.011299900080339454, 0.0018490709435263109, 0.00020427191530827845,
+        1.4844586873981299e-05, 6.8283193308711994e-07, 1.8810248410796733e-08, 2.8623502429738814e-10,
+        2.1270790332241028e-12, 6.2979670025178679e-15, 5.0504737000355127e-18, 4.1614623703728552e-22};
+
+    inline constexpr double laguerreRoots24[24] = {
+        0.05901985218150798, 0.31123914619848375, 0.76609690554593668, 1.4255975908036131,
+        2.2925620586321904, 3.3707742642089977, 4.6650837034671708, 6.1815351187367655,
+        7.9275392471721524, 9.9120980150777065, 12.146102711729766, 14.642732289596674,
+        17.417992646508978, 20.491460082616424, 23.887329848169735, 27.635937174332717,
+        31.776041352374722, 36.358405801651621, 41.451720484870769, 47.153106445156325,
+        53.608574544695067, 61.058531447218762, 69.962240035105026, 81.498279233948892};
+    inline constexpr double laguerreWeights24[24] = {
+        0.14281197333478185, 0.25877410751742391, 0.25880670727286981, 0.18332268897777804,
+        0.098166272629918894, 0.040732478151408645, 0.013226019405120156, 0.0033693490584783036,
+        0.00067216256409354793, 0.00010446121465927518, 1.2544721977993332e-05, 1.15131581273728e-06,
+        7.9608129591336304e-08, 4.0728589875499996e-09, 1.507008226292585e-10, 3.9177365150584513e-12,
+        6.8941810529580851e-14, 7.8198003824594483e-16, 5.3501888130100375e-18, 2.0105174645555034e-20,
+        3.6057658645529593e-23, 2.4518188458784027e-26, 4.0883015936806581e-30, 5.5753457883283566e-35};
+
+    inline constexpr double laguerreRoots32[32] = {
+        0.044489365833267021, 0.23452610951961853, 0.57688462930188644, 1.0724487538178176,
+        1.7224087764446454, 2.5283367064257947, 3.4922132730219944, 4.6164567697497674,
+        5.9039585041742439, 7.358126733186241, 8.9829409242125955, 10.783018632539973,
+        12.763697986742725, 14.931139755522556, 17.292454336715316, 19.855860940336054,
+        22.630889013196775, 25.628636022459247, 28.862101816323474, 32.346629153964734,
+        36.100494805751971, 40.14571977153944, 44.509207995754934, 49.224394987308642,
+        54.333721333396909, 59.892509162134019, 65.975377287935046, 72.687628090662713,
+        80.187446977913524, 88.735340417892402, 98.829542868283966, 111.7513980979377};
+    inline constexpr double laguerreWeights32[32] = {
+        0.10921834195238497, 0.21044310793881324, 0.23521322966984801, 0.19590333597288104,
+        0.12998378628607177, 0.070578623865717435, 0.031760912509175072, 0.011918214834838558,
+        0.0037388162946115247, 0.00098080330661495514, 0.0002148649188013642, 3.9203419679879469e-05,
+        5.9345416128686326e-06, 7.4164045786675519e-07, 7.6045678791207813e-08, 6.3506022266258064e-09,
+        4.281382971040929e-10, 2.3058994918913362e-11, 9.7993792887270935e-13, 3.2378016577292665e-14,
+        8.1718234434207193e-16, 1.5421338333938235e-17, 2.1197922901636187e-19, 2.0544296737880453e-21,
+        1.3469825866373952e-23, 5.6612941303973588e-26, 1.4185605454630368e-28, 1.9133754944542244e-31,
+        1.1922487600982224e-34, 2.671511219240137e-38, 1.3386169421062562e-42, 4.5105361938989741e-48};
+
+    inline constexpr double laguerreRoots48[48] = {
+        0.029811235829960109, 0.15710799061787631, 0.38626503757645558, 0.71757469411697228,
+        1.1513938340264347, 1.6881858234190472, 2.3285270066532289, 3.0731108616526388,
+        3.9227524130464806, 4.8783933559213457, 5.9411080546245589, 7.1121105358907437,
+        8.392762599091224, 9.7845831846873228, 11.289259168009528, 12.90865777828553,
+        14.644840883209707, 16.500081428964585, 18.476882386874113, 20.577998634022208,
+        22.80646229052137, 25.165612156439106, 27.659128044480529, 30.291071001008568,
+        33.065930662498744, 35.988681327478936, 39.06484876419777, 42.300590362903094,
+        45.702792038511468, 49.279186382836791, 53.038498087816663, 56.990624814804477,
+        61.146864786140227, 65.520206929018613, 70.125706236113189, 74.980977518911317,
+        80.10685735032439, 85.528311116034175, 91.275707993668092, 97.386667713581531,
+        103.90883335717625, 110.90422088497627, 118.45642504628363, 126.68342576888583,
+        135.7625895778643, 145.98643270946346, 157.915612022978, 172.99632814856326};
+    inline constexpr double laguerreWeights48[48] = {
+        0.074262005828026237, 0.15227194980935282, 0.19040908826391142, 0.18663305948480594,
+        0.15342420015757829, 0.10877969280749025, 0.067460738609219459, 0.036881194115821213,
+        0.017856844269156718, 0.0076776165144976085, 0.0029357859037394737, 0.00099906553781588573,
+        0.00030259801699225841, 8.1538711803554132e-05, 1.9531587157280726e-05, 4.1541829450521749e-06,
+        7.8337003802775868e-07, 1.3073947749206026e-07, 1.9270714080170285e-08, 2.5026389371263412e-09,
+        2.8557855087716224e-10, 2.8546224120591559e-11, 2.4910106849372247e-12, 1.8903366069715442e-13,
+        1.2421626859491528e-14, 7.0342315202126184e-16, 3.4145491485918871e-17, 1.4123154148957397e-18,
+        4.9442180080974849e-20, 1.4539524813678998e-21, 3.561068365004086e-23, 7.1940559964947241e-25,
+        1.185537228350586e-26, 1.5734913570756022e-28, 1.657285440919483e-30, 1.361434162716342e-32,
+        8.5461558139631363e-35, 4.0000905324813466e-37, 1.3550199911029975e-39, 3.2016367953549137e-42,
+        5.035869166061096e-45, 4.9624875407027329e-48, 2.8235107161201125e-51, 8.2684460695050638e-55,
+        1.049064847821272e-58, 4.3465744227388566e-63, 3.434736438396578e-68, 1.3190660883980166e-74};
+
+    inline constexpr double laguerreRoots64[64] = {
+        0.022415874146705279, 0.11812251209677048, 0.2903657440180365, 0.53928622122797909,
+        0.86503700464811395, 1.2678140407752414, 1.7478596260594363, 2.3054637393075086,
+        2.9409651567252517, 3.6547526502072905, 4.4472663433130943, 5.31899925449639,
+        6.2704990469236543, 7.3023700025873959, 8.4152752394830248, 9.6099391927961086,
+        10.887150383886372, 12.247764504244302, 13.692707845547504, 15.222981111524728,
+        16.839663652648738, 18.54391817085919, 20.336995948730234, 22.220242665950877,
+        24.195104875933254, 26.263137227118484, 28.426010527501028, 30.685520767525972,
+        33.043599236437828, 35.502323891141209, 38.06393216564647, 40.730835444458627,
+        43.505635466421531, 46.391142978616195, 49.390399025624689, 52.506699341346298,
+        55.743622413278381, 59.105061919017103, 62.595264400151393, 66.218873251247558,
+        69.980980377146835, 73.887187232482958, 77.943677434463126, 82.157303778319303,
+        86.535693349456523, 91.087375613133091, 95.821940015520738, 100.75023196951398,
+        105.88459946879995, 111.23920752443958, 116.8304450513065, 122.67746026853858,
+        128.80287876923768, 135.23378794952583, 142.00312148993152, 149.15166590004938,
+        156.73107513267115, 164.80860265515054, 173.47494683642427, 182.85820469143147,
+        193.15113603707292, 204.67202848505946, 218.03185193532852, 234.80957917132616};
+    inline constexpr double laguerreWeights64[64] = {
+        0.056252842339029843, 0.11902398731242603, 0.15749640386214453, 0.16754705041577395,
+        0.15335285577923663, 0.12422105360932975, 0.090342300986485061, 0.059477755768355026,
+        0.035627518904036072, 0.019480410431166405, 0.0097435948993820024, 0.0044643103641662752,
+        0.0018753595813231149, 0.00072264698157500516, 0.00025548753283349671, 8.2871435343969424e-05,
+        2.4656863967885589e-05, 6.7267138788296688e-06, 1.681785369964089e-06, 3.8508129815466843e-07,
+        8.0687280409904995e-08, 1.5457237067576888e-08, 2.7044801476174814e-09, 4.3167754754272009e-10,
+        6.2777525417614528e-11, 8.3063173762889584e-12, 9.9840317872201638e-13, 1.0883538871166626e-13,
+        1.0740174034415902e-14, 9.5757372315744419e-16, 7.6970280236485864e-17, 5.5648811374540257e-18,
+        3.6097564090104467e-19, 2.0950953695489463e-20, 1.0847933010975493e-21, 4.9946994863638039e-23,
+        2.0378369745988224e-24, 7.339537564278837e-26, 2.3237830821986943e-27, 6.4382347069087625e-29,
+        1.5531210957882753e-30, 3.2442500920195374e-32, 5.8323862678362014e-34, 8.9632548331028534e-36,
+        1.1687039895507363e-37, 1.2820559843599804e-39, 1.1720949374050023e-41, 8.8353396723286052e-44,
+        5.4249555903061868e-46, 2.6755426666788939e-48, 1.0429170314113671e-50, 3.1529023519577725e-53,
+        7.2295419106475227e-56, 1.2242353012300822e-58, 1.4821685049019104e-61, 1.2325193488145188e-64,
+        6.6914990045712694e-68, 2.220465941850449e-71, 4.1209460947388761e-75, 3.7743990618964891e-79,
+        1.4141150529176194e-83, 1.5918330640413678e-88, 2.9894843488606342e-94, 2.0890635084369527e-101};
+
+    inline constexpr double laguerreRoots96[96] = {
+        0.014982473862797356, 0.07894612304880208, 0.19403943619415145, 0.36031849940301369,
+        0.5778305997114499, 0.84663433340836913, 1.1668015752788021, 1.538417935202955,
+        1.9615829778382894, 2.4364104013990189, 2.9630282193904725, 3.5415789580835457,
+        4.1722198744791781, 4.855123197087293, 5.590476391052805, 6.3784824489169116,
+        7.2193602082647388, 8.113344697561967, 9.0606875115786671, 10.061657217920365,
+        11.116539796327313, 12.225639112560641, 13.389277428867983, 14.607795953212266,
+        15.881555429656906, 17.210936772530591, 18.596341747247472, 20.038193700936485,
+        21.536938346340012, 23.093044602780189, 24.707005498365575, 26.379339138025454,
+        28.110589742419666, 29.90132876328396, 31.752156081341955, 33.66370129355208,
+        35.63662509717134, 37.671620778917152, 39.769415818406571, 41.930773616063341,
+        44.156495356822944, 46.447422022255019, 48.80443656518198, 51.22846626253061,
+        53.720485264039453, 56.2815173565969, 58.91263896644579, 61.614982424312103,
+        64.389739521759253, 67.238165390809257, 70.161582743195794, 73.16138651062802,
+        76.239048933276436, 79.39612515049825, 82.634259355789894, 85.955191587319689,
+        89.360765236439903, 92.852935369656137, 96.433777975079863, 100.10550026295192,
+        103.87045217208401, 107.73113926088293, 111.69023719409228, 115.75060807590457,
+        119.915318928456, 124.18766267424256, 128.57118205471409, 133.06969700919888,
+        137.68733615365946, 142.42857314463936, 147.29826889966063, 152.30172088426704,
+        157.44472098579493, 162.73362389978385, 168.17542849200797, 173.77787531794405,
+        179.54956445549479, 185.50009914428216, 191.64026258848975, 197.98223791899625,
+        204.53988511337843, 211.329094261168, 218.36824295658661, 225.67879852346945,
+        233.28612622783123, 241.22059803677632, 249.51915306252911, 258.22756081641921,
+        267.40382415709865, 277.12352531608184, 287.48869682640986, 298.64361369930475,
+        310.80567968618624, 324.33445041231465, 339.92140931073067, 359.35766828583968};
+    inline constexpr double laguerreWeights96[96] = {
+        0.037878576219041546, 0.082719906098347604, 0.11586679913398469, 0.13383230013229358,
+        0.13643330361645334, 0.1262862120356478, 0.10769248887981028, 0.085324129111590666,
+        0.063142032425207273, 0.043798382308331558, 0.028546448879549692, 0.017512866194977873,
+        0.01012564796759256, 0.0055227025997542194, 0.0028434084753551059, 0.0013826116758439606,
+        0.00063516477171742512, 0.00027573996998787751, 0.00011313616189049866, 4.3875183098015112e-05,
+        1.6082397760724063e-05, 5.5714800483349181e-06, 1.8240205636508686e-06, 5.6423468574705264e-07,
+        1.6488229499853934e-07, 4.5506013933715988e-08, 1.1858354666076145e-08, 2.9167956106813563e-09,
+        6.769611683671967e-10, 1.4819499836703111e-10, 3.0587004517378574e-11, 5.9495123132094935e-12,
+        1.0900841006155018e-12, 1.8804063918285553e-13, 3.0522549840680182e-14, 4.6592577331620246e-15,
+        6.6845736377435155e-16, 9.0076248365653198e-17, 1.139275645645739e-17, 1.3514961973993145e-18,
+        1.5025758407269363e-19, 1.5643840201992151e-20, 1.5239352071253463e-21, 1.3877670300200888e-22,
+        1.1802752794173012e-23, 9.3655729231494817e-25, 6.9265012876891078e-26, 4.7691560402894744e-27,
+        3.0535883693639162e-28, 1.8158763395675336e-29, 1.0016239729606731e-30, 5.1176440544320741e-32,
+        2.418537832219781e-33, 1.0555712006884411e-34, 4.2478548465303328e-36, 1.5734512604770775e-37,
+        5.3548530878626396e-39, 1.6711413862360289e-40, 4.7726385928403189e-42, 1.244615423272114e-43,
+        2.9568746250610227e-45, 6.3837270537895551e-47, 1.2491323725684232e-48, 2.2090419771352511e-50,
+        3.5199864956784987e-52, 5.0373518882812515e-54, 6.4515324170648229e-56, 7.3667911735811718e-58,
+        7.4691524628391474e-60, 6.69446397277809e-62, 5.278604705317516e-64, 3.6425104071068617e-66,
+        2.1870947493414928e-68, 1.1354926714502458e-70, 5.0621957528006923e-73, 1.9230945557151248e-75,
+        6.1726197815267111e-78, 1.6581163669346998e-80, 3.68807828510868e-83, 6.7110039069269446e-86,
+        9.8541871009330065e-89, 1.1494072769098418e-91, 1.0458167774934305e-94, 7.2669524190188803e-98,
+        3.7608310089871669e-101, 1.4067947939056763e-104, 3.6675043999190524e-108, 6.3696566139178502e-112,
+        6.9609778479775341e-116, 4.4438836811384631e-120, 1.4993336611852932e-124, 2.3211258953013404e-129,
+        1.3332838377056072e-134, 2.0026002659659085e-140, 4.0287862132504579e-147, 1.9574149519693185e-155};
+
+    inline constexpr double laguerreRoots128[128] = {
+        0.011251388263675962, 0.059284741269026456, 0.14570796659431245, 0.27055317875866508,
+        0.43384140755383682, 0.63559766578162191, 0.87585238454652081, 1.154641701974398,
+        1.4720075631667355, 1.8279977783123502, 2.2226660715619024, 2.6560721298834813,
+        3.1282816550279171, 3.6393664198524034, 4.1894043295940477, 4.7784794884348765,
+        5.4066822716004994, 6.0741094031965366, 6.7808640399756257, 7.5270558612293756,
+        8.3128011650077713, 9.1382229708803919, 10.003451129468223, 10.908622438990882,
+        11.853880769091857, 12.83937719222325, 13.865270122892081, 14.931725465091928,
+        16.038916768267079, 17.187025392181265, 18.376240681089694, 19.606760147641648,
+        20.878789666971372, 22.192543681467836, 23.548245416748919, 24.946127109403488,
+        26.386430247105292, 27.86940582174639, 29.395314596284912, 30.964427386052755,
+        32.577025355323748, 34.23340033000224, 35.933855127356154, 37.678703903788374,
+        39.468272521715761, 41.302898936707088, 43.182933606120386, 45.108739920577229,
+        47.080694659717217, 49.099188473791024, 51.164626392776661, 53.277428364840773,
+        55.438029826117891, 57.646882303945226, 59.904454055872058, 62.211230746961455,
+        64.567716168121208, 66.974432998441557, 69.431923614783429, 71.940750952154374,
+        74.501499418734028, 77.114775869770568, 79.781210644968553, 82.501458674431447,
+        85.276200658715354, 88.106144329099507, 90.99202579479261, 93.93461098447969,
+        96.934697190381939, 99.993114723864267, 103.11072869259398, 106.28844091034544,
+        109.52719195177755, 112.8279633659042, 116.19178006355678, 119.61971289593201,
+        123.11288144336019, 126.67245703576019, 130.29966602891346, 133.99579336374796,
+        137.76218643933939, 141.60025933439303, 145.51149741665958, 149.4974623851777,
+        153.55979779656644, 157.70023513397811, 161.92060048597563, 166.22282191276886,
+        170.60893758924223, 175.0811048284146, 179.64161010586699, 184.2928802258468,
+        189.0374947939541, 193.87820019047297, 198.81792527372059, 203.85979908576985,
+        209.00717088551087, 214.26363289878802, 219.63304625557817, 225.11957068420904,
+        230.72769865820362, 236.46229485017767, 242.3286419497027, 248.33249416235719,
+        254.48014004486913, 260.77847677357971, 267.23509852895381, 273.85840246269362,
+        280.65771677632347, 287.64345689921936, 294.82731778764776, 302.22251324644947,
+        309.84407732661265, 317.70924895490629, 325.83797012119493, 334.25354206765411,
+        342.9835062738253, 352.06085354652618, 361.52572639232505, 371.42788921432754,
+        381.8304441190611, 392.81567124080811, 404.49472475051505, 417.02490297798903,
+        430.64344416659736, 445.743096973928, 463.08003410944627, 484.61554398644398};
+    inline constexpr double laguerreWeights128[128] = {
+        0.02855184445323973, 0.063350211784505117, 0.091308381366134311, 0.10991390041091174,
+        0.1182741710341737, 0.11704573900040673, 0.10808998754556842, 0.093942888638928496,
+        0.077253668797898051, 0.060327056265661573, 0.044847348247195211, 0.031796947936876846,
+        0.021530149453794445, 0.013936951733846348, 0.0086315853802022471, 0.0051177770136692285,
+        0.002906347436485956, 0.0015814329433166793, 0.00082473898509881219, 0.00041232608853969475,
+        0.00019764942644259149, 9.0851578878245145e-05, 4.0048492783580529e-05, 1.6930762398081785e-05,
+        6.8645252911106823e-06, 2.6692165981421026e-06, 9.9536401028638451e-07, 3.5594357530030653e-07,
+        1.220532551948812e-07, 4.0127919209356354e-08, 1.2648114147475978e-08, 3.821489729426572e-09,
+        1.1066410592273417e-09, 3.0710092370974232e-10, 8.1654993841544892e-11, 2.0798536327813777e-11,
+        5.0739537708398708e-12, 1.1853143771796112e-12, 2.6509275237288735e-13, 5.6746322157576585e-14,
+        1.1623738147075159e-14, 2.2777662927023864e-15, 4.2688319702976491e-16, 7.6492887993632753e-17,
+        1.3101313919838247e-17, 2.1441452341246637e-18, 3.3519442872088478e-19, 5.0037330864594739e-20,
+        7.1300306419585616e-21, 9.6945407403972662e-22, 1.2572847556397845e-22, 1.5546610955630634e-23,
+        1.8321097932534219e-24, 2.056797978136735e-25, 2.1986660526232913e-26, 2.2369160073242894e-27,
+        2.1649606446339055e-28, 1.9922276806187937e-29, 1.7421538863254398e-30, 1.4469497861062846e-31,
+        1.1407517061230823e-32, 8.5318050978102092e-34, 6.0497011779388589e-35, 4.0643432432648003e-36,
+        2.5853493749879097e-37, 1.5560287625226235e-38, 8.8546258496633296e-40, 4.7604575173645812e-41,
+        2.4160785106612322e-42, 1.1566470503387376e-43, 5.2185106194923757e-45, 2.2169743353361802e-46,
+        8.8601027566136965e-48, 3.3278111592010955e-49, 1.1734900430783024e-50, 3.8809677264209216e-52,
+        1.2024263279330613e-53, 3.4860230441055464e-55, 9.4455452215955674e-57, 2.3888842745596839e-58,
+        5.6318847507546302e-60, 1.2359286119121601e-61, 2.5210042023772674e-63, 4.7722246219998056e-65,
+        8.3700198919995785e-67, 1.3578243411202098e-68, 2.0336887271531543e-70, 2.8068384806953537e-72,
+        3.5625676070620959e-74, 4.1494527492937707e-76, 4.4250079657663219e-78, 4.31008426128985e-80,
+        3.8246610167617397e-82, 3.0835478425987927e-84, 2.2521398221706209e-86, 1.4855147406450432e-88,
+        8.8196354763726564e-91, 4.6964178221259851e-93, 2.2343938254547729e-95, 9.4587870382207408e-98,
+        3.5469608312406727e-100, 1.1725321300348872e-102, 3.3990905556399154e-105, 8.5919072006238984e-108,
+        1.8818913973535359e-110, 3.5473586323062567e-113, 5.7114822282836e-116, 7.7894737880444613e-119,
+        8.915898699491269e-122, 8.4768563588684034e-125, 6.6173269354949004e-128, 4.1862163574157094e-131,
+        2.114385168981142e-134, 8.3821635013678691e-138, 2.557202302197678e-141, 5.8667686421912047e-145,
+        9.849861030064843e-149, 1.171383943342069e-152, 9.4839632655673835e-157, 4.9770963811238032e-161,
+        1.5908985277509976e-165, 2.8563038291190028e-170, 2.5822507196914901e-175, 1.0073502500507974e-180,
+        1.3442525004438164e-186, 4.1829622140368346e-193, 1.4571653077261863e-200, 8.6405916904687085e-210};
+
+    inline constexpr Table gaussLaguerre[] = {
+        {8, laguerreRoots8, laguerreWeights8},
+        {16, laguerreRoots16, laguerreWeights16},
+        {24, laguerreRoots24, laguerreWeights24},
+        {32, laguerreRoots32, laguerreWeights32},
+        {48, laguerreRoots48, laguerreWeights48},
+        {64, laguerreRoots64, laguerreWeights64},
+        {96, laguerreRoots96, laguerreWeights96},
+        {128, laguerreRoots128, laguerreWeights128}};
+}
@@ -1,6 +1,7 @@
 #pragma once 
 #include <iostream>
 #include <vector>
+#include <chrono>
 #include <Eigen/Dense>
 #include "loss.hpp"
 #include "errors.hpp"
@@ -0,0 +1,49 @@
+#pragma once
+#include <iostream>
+#include <vector>
+#include <Eigen/Dense>
+#include "curveinterpolation.hpp"
+
+// Interpolation of a surface given on a strike x expiry grid: along strikes within each expiry row, then
+// across the rows. The row curves are built once; the curve across rows being linear in the row values,
+// it is stored as the cardinal curves of the expiry knots (the curve through each unit vector), so that a
+// query only sums row values against their weights, without building or solving anything.
+class SurfaceInterpolation
+{
+    public:
+        enum class Method {BILINEAR, BICUBIC};
+
+        // values(i, j) is the value at expiries[i] and strikes[j]: one row per expiry.
+        SurfaceInterpolation(const std::vector<double>& strikes, const std::vector<double>& expiries, const Eigen::Ref<const Eigen::MatrixXd>& values, const Method& method = Method::BICUBIC);
+        ~SurfaceInterpolation() = default;
+
+        double evaluate(double strike, double expiry) const;
+
+        // Batched evaluation at the points (strikes[k], expiries[k]), with the CurveInterpolation conventions:
+        // out is resized to the number of points, out-of-range points are set to NAN and reported by a false
+        // return value instead of throwing.
+        bool evaluate(const std::vector<double>& strikes, const std::vector<double>& expiries, std::vector<double>& out) const;
+
+        Method getMethod() const;
+        int getNumberStrikes() const;
+        int getNumberExpiries() const;
+        double getLowerBoundStrike() const;
+        double getUpperBoundStrike() const;
+        double getLowerBoundExpiry() const;
+        double getUpperBoundExpiry() const;
+
+    private:
+        using Segment = CurvePolicy::Cubic::Segment;
+
+        void classSetter(const Eigen::Ref<const Eigen::MatrixXd>& values);
+        void buildSegments(const std::vector<double>& x, const std::vector<double>& y, Segment* out) const;
+        static int findIndex(const std::vector<double>& knots, double x);
+        bool isInRange(double strike, double expiry) const;
+        double evaluatePoint(double strike, double expiry) const;
+
+        std::vector<double> strikes_, expiries_;
+        Method method_;
+        // rows_[i * strikes + j]: segment j of expiry row i; weights_[k * expiries + i]: segment k of the
+        // cardinal curve of expiry i. Linear segments are stored with c = d = 0.
+        std::vector<Segment> rows_, weights_;
+};
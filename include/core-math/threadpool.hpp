@@ -0,0 +1,61 @@
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+
+// Work-stealing thread pool. Each worker owns a task queue, runs its own tasks last-in first-out and, when
+// it runs dry, steals the oldest task of another worker. Threads waiting on the pool (wait, parallelFor)
+// run queued tasks instead of blocking, so a task may itself wait on the pool.
+class ThreadPool
+{
+    public:
+        // numberThreads <= 0 uses std::thread::hardware_concurrency().
+        explicit ThreadPool(int numberThreads = 0);
+        ~ThreadPool();
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        int getNumberThreads() const;
+
+        void submit(std::function<void()> task);
+
+        // Blocks until every submitted task has run. The first exception thrown by a task is rethrown here.
+        // Called from a task, it does not wait for the tasks that are themselves blocked in wait(), the
+        // calling one included.
+        void wait();
+
+        // Runs f(i) for i in [0, n) on the pool and returns when all of them are done. The first exception
+        // thrown by f is rethrown, once every other index has run.
+        void parallelFor(int n, const std::function<void(int)>& f);
+
+    private:
+        struct Queue
+        {
+            std::mutex mutex;
+            std::deque<std::function<void()>> tasks;
+        };
+
+        void workerLoop(int index);
+        bool runTask(int index);
+        void waitFor(const std::function<bool()>& done);
+        int getCurrentQueue() const;
+
+        std::vector<std::unique_ptr<Queue>> queues_;
+        std::vector<std::thread> workers_;
+        std::mutex mutex_;
+        std::condition_variable condition_;
+        std::atomic<int> queued_;
+        std::atomic<int> pending_;
+        std::atomic<int> waiting_;
+        std::atomic<unsigned> next_;
+        bool stop_;
+        std::exception_ptr error_;
+};
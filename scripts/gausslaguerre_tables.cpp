@@ -0,0 +1,115 @@
+// Generates include/core-math/quadraturetables.hpp: Gauss-Laguerre nodes and weights (alpha = 0) for the
+// tabulated sizes, computed in __float128 and rounded once to double.
+//
+//     g++ -std=gnu++17 -O2 scripts/gausslaguerre_tables.cpp -lquadmath -o gausslaguerre_tables
+//     ./gausslaguerre_tables > include/core-math/quadraturetables.hpp
+//
+// The nodes are the eigenvalues of the Jacobi matrix (implicit QL), polished by Newton steps on L_n. The
+// weights come from w_i = x_i / ((n + 1) L_{n+1}(x_i))^2, which keeps full relative accuracy for the tiny
+// weights of the largest nodes (eigenvector components only have absolute accuracy).
+#include <cstdio>
+#include <vector>
+#include <quadmath.h>
+
+using Real = __float128;
+
+static const int sizes[] = {8, 16, 24, 32, 48, 64, 96, 128};
+
+// L_n(x) and L_{n-1}(x) by the three-term recurrence.
+static void laguerre(int n, Real x, Real& ln, Real& lnm1)
+{
+    Real previous = 1, current = 1 - x;
+    for (int k = 1; k < n; ++k) {
+        Real next = ((2 * k + 1 - x) * current - k * previous) / (k + 1);
+        previous = current;
+        current = next;
+    }
+    ln = n == 0 ? 1 : current;
+    lnm1 = n == 0 ? 0 : previous;
+}
+
+// Eigenvalues of the symmetric tridiagonal matrix (d, e), e[i] coupling i and i + 1.
+static void eigenvalues(std::vector<Real>& d, std::vector<Real> e)
+{
+    int n = d.size();
+    e.push_back(0);
+    for (int l = 0; l < n; ++l) {
+        int m;
+        do {
+            for (m = l; m < n - 1; ++m) {
+                Real dd = fabsq(d[m]) + fabsq(d[m + 1]);
+                if (fabsq(e[m]) <= FLT128_EPSILON * dd) break;
+            }
+            if (m == l) break;
+            Real g = (d[l + 1] - d[l]) / (2 * e[l]);
+            Real r = hypotq(g, 1);
+            g = d[m] - d[l] + e[l] / (g + (g >= 0 ? fabsq(r) : -fabsq(r)));
+            Real s = 1, c = 1, p = 0;
+            int i;
+            for (i = m - 1; i >= l; --i) {
+                Real f = s * e[i], b = c * e[i];
+                e[i + 1] = r = hypotq(f, g);
+                if (r == 0) {d[i + 1] -= p; e[m] = 0; break;}
+                s = f / r;
+                c = g / r;
+                g = d[i + 1] - p;
+                r = (d[i] - g) * s + 2 * c * b;
+                p = s * r;
+                d[i + 1] = g + p;
+                g = c * r - b;
+            }
+            if (r == 0 && i >= l) continue;
+            d[l] -= p;
+            e[l] = g;
+            e[m] = 0;
+        } while (m != l);
+    }
+}
+
+static void print(const char* name, int n, const std::vector<double>& values)
+{
+    std::printf("    inline constexpr double %s%d[%d] = {", name, n, n);
+    for (int i = 0; i < n; ++i) {
+        std::printf("%s%.17g", i == 0 ? "\n        " : (i % 4 == 0 ? ",\n        " : ", "), values[i]);
+    }
+    std::printf("};\n");
+}
+
+int main()
+{
+    std::printf("#pragma once\n\n");
+    std::printf("// Generated by scripts/gausslaguerre_tables.cpp, do not edit: Gauss-Laguerre nodes and weights (alpha = 0), \n");
+    std::printf("// computed in __float128 and rounded to double.\n");
+    std::printf("namespace QuadratureTables\n{\n");
+    std::printf("    struct Table\n    {\n        int points; \n        const double* roots; \n        const double* weights; \n    };\n\n");
+    for (int n : sizes) {
+        std::vector<Real> d(n), e(n - 1);
+        for (int k = 0; k < n; ++k) d[k] = 2 * k + 1;
+        for (int k = 0; k < n - 1; ++k) e[k] = k + 1;
+        eigenvalues(d, e);
+        std::vector<double> roots(n), weights(n);
+        std::vector<Real> x(d);
+        // Insertion sort: ascending nodes.
+        for (int i = 1; i < n; ++i) for (int j = i; j > 0 && x[j] < x[j - 1]; --j) {Real t = x[j]; x[j] = x[j - 1]; x[j - 1] = t;}
+        for (int i = 0; i < n; ++i) {
+            for (int k = 0; k < 3; ++k) {
+                Real ln, lnm1;
+                laguerre(n, x[i], ln, lnm1);
+                x[i] -= ln * x[i] / (n * (ln - lnm1));
+            }
+            Real lnp1, ln;
+            laguerre(n + 1, x[i], lnp1, ln);
+            roots[i] = static_cast<double>(x[i]);
+            weights[i] = static_cast<double>(x[i] / ((n + 1) * (n + 1) * lnp1 * lnp1));
+        }
+        print("laguerreRoots", n, roots);
+        print("laguerreWeights", n, weights);
+        std::printf("\n");
+    }
+    std::printf("    inline constexpr Table gaussLaguerre[] = {");
+    for (std::size_t k = 0; k < sizeof(sizes) / sizeof(sizes[0]); ++k) {
+        std::printf("%s{%d, laguerreRoots%d, laguerreWeights%d}", k == 0 ? "\n        " : ",\n        ", sizes[k], sizes[k], sizes[k]);
+    }
+    std::printf("};\n}\n");
+    return 0;
+}
@@ -1,153 +1,614 @@
 #include "../include/core-math/curveinterpolation.hpp"
 
-CurveInterpolation::CurveInterpolation(const std::map<double, double>& data){classSetter(data);}
+CurveInterpolation::CurveInterpolation(const std::map<double, double>& data): borrowedX_(nullptr)
+{
+    xVector_.reserve(data.size());
+    for(auto const& imap: data) {xVector_.push_back(imap.first);}
+    classSetter(data.size());
+}
+
+CurveInterpolation::CurveInterpolation(const std::vector<double>& x, const std::vector<double>& y): xVector_(x), borrowedX_(nullptr)
+{
+    if (x.size() != y.size()) throw MathErrorRegistry::CurveInterpolation::MismatchVectorSizeError();
+    classSetter(x.size());
+}
+
+CurveInterpolation::CurveInterpolation(const Eigen::Ref<const Eigen::VectorXd>& x, const Eigen::Ref<const Eigen::VectorXd>& y): 
+xVector_(x.data(), x.data() + x.size()), borrowedX_(nullptr)
+{
+    if (x.size() != y.size()) throw MathErrorRegistry::CurveInterpolation::MismatchVectorSizeError();
+    classSetter(x.size());
+}
+
+CurveInterpolation::CurveInterpolation(const Eigen::Map<const Eigen::VectorXd>& x, const Eigen::Map<const Eigen::VectorXd>& y, const Storage& storage): 
+borrowedX_(storage == Storage::BORROWED ? x.data() : nullptr)
+{
+    if (x.size() != y.size()) throw MathErrorRegistry::CurveInterpolation::MismatchVectorSizeError();
+    if (storage == Storage::OWNED) xVector_.assign(x.data(), x.data() + x.size());
+    classSetter(x.size());
+}
 
-void CurveInterpolation::classSetter(const std::map<double, double>& data)
+void CurveInterpolation::classSetter(int n)
 {
-    int n = data.size();
     if (n < 2){throw MathErrorRegistry::CurveInterpolation::WrongVectorSizeError();}
-    int i = 0;
-    for(auto const& imap: data)
+    numberKnots_ = n;
+    const double* knots = getKnots();
+    for (int i = 1; i < n; i++)
     {
-        if (i == 0){lowerBoundX_ = imap.first;}
-        if (i == n-1){upperBoundX_ = imap.first;}
-        i++;
-        xVector_.push_back(imap.first);
-        yVector_.push_back(imap.second);
-        
-    }    
+        if (!(knots[i] > knots[i - 1])) throw MathErrorRegistry::CurveInterpolation::UnsortedKnotsError();
+    }
+    lowerBoundX_ = knots[0];
+    upperBoundX_ = knots[n - 1];
+
+    inverseStep_ = (n - 1) / (upperBoundX_ - lowerBoundX_);
+    double step = 1.0 / inverseStep_;
+    double maxDeviation = 0.0;
+    for (int j = 1; j < n - 1; j++) maxDeviation = std::max(maxDeviation, std::abs(knots[j] - (lowerBoundX_ + j * step)));
+    setLookupMethod(maxDeviation <= 0.25 * step ? LookupMethod::UNIFORM_GRID : LookupMethod::BINARY_SEARCH);
 }
 
-double CurveInterpolation::evaluate(double x) const
+void CurveInterpolation::setLookupMethod(const LookupMethod& method)
 {
-    if (x < lowerBoundX_ || x > upperBoundX_) throw MathErrorRegistry::CurveInterpolation::OutOfRangeCurveInterpolationError();
-    return _evaluate(x);
+    lookupMethod_ = method;
+    buckets_.clear();
+    if (method == LookupMethod::BUCKET_TABLE)
+    {
+        // One bucket per interval, each holding the lookup result of its left edge.
+        int n = numberKnots_;
+        const double* knots = getKnots();
+        buckets_.resize(n - 1);
+        double step = 1.0 / inverseStep_;
+        for (int b = 0; b < n - 1; b++)
+        {
+            buckets_[b] = std::upper_bound(knots + 1, knots + n, lowerBoundX_ + b * step) - knots;
+        }
+    }
 }
 
-double CurveInterpolation::evaluateFirstDerivative(double x) const
+CurveInterpolation::LookupMethod CurveInterpolation::getLookupMethod() const {return lookupMethod_;}
+
+bool CurveInterpolation::isInRange(double x) const {return x >= lowerBoundX_ && x <= upperBoundX_;}
+
+double CurveInterpolation::evaluatePoint(double x, Kernel kernel, int* hint) const
 {
-    if (x < lowerBoundX_ || x > upperBoundX_) throw MathErrorRegistry::CurveInterpolation::OutOfRangeCurveInterpolationError();
-    return _evaluateFirstDerivative(x);
+    if (!isInRange(x)) throw MathErrorRegistry::CurveInterpolation::OutOfRangeCurveInterpolationError();
+    int i = hint ? (*hint = findIndex(x, *hint)) : findIndex(x);
+    double result;
+    (this->*kernel)(&x, &i, &result, 1);
+    return result;
 }
 
-double CurveInterpolation::evaluateSecondDerivative(double x) const
+bool CurveInterpolation::evaluateBatch(const std::vector<double>& x, std::vector<double>& out, Kernel kernel, int* hint) const
 {
-    if (x < lowerBoundX_ || x > upperBoundX_) throw MathErrorRegistry::CurveInterpolation::OutOfRangeCurveInterpolationError();
-    return _evaluateSecondDerivative(x);
+    int n = x.size();
+    out.resize(n);
+    int index[BATCH_BLOCK_SIZE];
+    for (int start = 0; start < n; start += BATCH_BLOCK_SIZE)
+    {
+        int m = std::min(BATCH_BLOCK_SIZE, n - start);
+        if (hint)
+        {
+            for (int k = 0; k < m; k++) index[k] = *hint = findIndex(x[start + k], *hint);
+        }
+        else
+        {
+            for (int k = 0; k < m; k++) index[k] = findIndex(x[start + k]);
+        }
+        (this->*kernel)(x.data() + start, index, out.data() + start, m);
+    }
+    bool inRange = true;
+    for (int k = 0; k < n; k++)
+    {
+        if (!isInRange(x[k])) {out[k] = NAN; inRange = false;}
+    }
+    return inRange;
+}
+
+double CurveInterpolation::evaluate(double x) const {return evaluatePoint(x, &CurveInterpolation::_evaluate);}
+double CurveInterpolation::evaluateFirstDerivative(double x) const {return evaluatePoint(x, &CurveInterpolation::_evaluateFirstDerivative);}
+double CurveInterpolation::evaluateSecondDerivative(double x) const {return evaluatePoint(x, &CurveInterpolation::_evaluateSecondDerivative);}
+
+bool CurveInterpolation::evaluate(const std::vector<double>& x, std::vector<double>& out) const 
+{
+    return evaluateBatch(x, out, &CurveInterpolation::_evaluate);
+}
+
+bool CurveInterpolation::evaluateFirstDerivative(const std::vector<double>& x, std::vector<double>& out) const 
+{
+    return evaluateBatch(x, out, &CurveInterpolation::_evaluateFirstDerivative);
+}
+
+bool CurveInterpolation::evaluateSecondDerivative(const std::vector<double>& x, std::vector<double>& out) const 
+{
+    return evaluateBatch(x, out, &CurveInterpolation::_evaluateSecondDerivative);
+}
+
+double CurveInterpolation::getGridPosition(double x) const
+{
+    // Position of x on the uniform grid spanning the knots, clamped to [0, n-1) (NaN maps to 0).
+    double t = (x - lowerBoundX_) * inverseStep_;
+    double cap = numberKnots_ - 1.5;
+    if (!(t > 0.0)) t = 0.0;
+    if (t > cap) t = cap;
+    return t;
 }
 
 int CurveInterpolation::findIndex(double x) const
 {
-    if (x < lowerBoundX_ || x > upperBoundX_) throw MathErrorRegistry::CurveInterpolation::OutOfRangeCurveInterpolationError();
-    if (x==lowerBoundX_) return 1; 
-    if (x==upperBoundX_) return xVector_.size();
-    auto it = std::lower_bound(xVector_.begin(), xVector_.end(), x);
-    int i = std::distance(xVector_.begin(), it);
-    return i;
+    // Returns i such that x lies in [x_{i-1}, x_i), or the knot count when x is the last knot, so that 
+    // every knot is evaluated exactly at the start of its own segment. Out-of-range values are clamped, 
+    // callers are responsible for the range check.
+    switch (lookupMethod_)
+    {
+        case LookupMethod::UNIFORM_GRID: return findIndex(x, static_cast<int>(getGridPosition(x)) + 1);
+        case LookupMethod::BUCKET_TABLE: return findIndex(x, buckets_[static_cast<int>(getGridPosition(x))]);
+        default: break;
+    }
+    const double* knots = getKnots();
+    return std::upper_bound(knots + 1, knots + numberKnots_, x) - knots;
+}
+
+int CurveInterpolation::findIndex(double x, int hint) const
+{
+    // Same result as findIndex(x), found by galloping away from a previous result: the bracket 
+    // doubles until it contains x and is then binary searched, O(log d) for a jump of d knots.
+    const int n = numberKnots_;
+    const double* knots = getKnots();
+    int lo, hi;
+    if (hint > 1 && !(x >= knots[hint - 1]))
+    {
+        hi = hint - 1;
+        int probe = hi - 1, step = 1;
+        while (probe >= 1 && knots[probe] > x) {hi = probe; probe -= step; step *= 2;}
+        lo = std::max(probe + 1, 1);
+    }
+    else 
+    {
+        lo = std::max(hint, 1);
+        int probe = lo, step = 1;
+        while (probe < n && knots[probe] <= x) {lo = probe + 1; probe = lo + step; step *= 2;}
+        hi = std::min(probe, n);
+    }
+    return std::upper_bound(knots + lo, knots + hi, x) - knots;
 }
 
 double CurveInterpolation::getLowerBoundX() const{return lowerBoundX_;}
 double CurveInterpolation::getUpperBoundX() const{return upperBoundX_;}
-double CurveInterpolation::getX(int i) const {return xVector_[i];};
-double CurveInterpolation::getY(int i) const {return yVector_[i];};
-std::vector<double> CurveInterpolation::getVectorX() const {return xVector_;}
-std::vector<double> CurveInterpolation::getVectorY() const {return yVector_;}
+int CurveInterpolation::getNumberKnots() const {return numberKnots_;}
+double CurveInterpolation::getX(int i) const {return getKnots()[i];};
+const double* CurveInterpolation::getKnots() const {return borrowedX_ ? borrowedX_ : xVector_.data();}
+
+CurveInterpolation::Cursor CurveInterpolation::getCursor() const {return CurveInterpolation::Cursor(*this);}
+
+CurveInterpolation::Cursor::Cursor(const CurveInterpolation& curve): curve_(curve), index_(1){}
+
+int CurveInterpolation::Cursor::getIndex() const {return index_;}
+void CurveInterpolation::Cursor::reset() {index_ = 1;}
+
+double CurveInterpolation::Cursor::evaluate(double x) 
+{
+    return curve_.evaluatePoint(x, &CurveInterpolation::_evaluate, &index_);
+}
+
+double CurveInterpolation::Cursor::evaluateFirstDerivative(double x) 
+{
+    return curve_.evaluatePoint(x, &CurveInterpolation::_evaluateFirstDerivative, &index_);
+}
+
+double CurveInterpolation::Cursor::evaluateSecondDerivative(double x) 
+{
+    return curve_.evaluatePoint(x, &CurveInterpolation::_evaluateSecondDerivative, &index_);
+}
+
+bool CurveInterpolation::Cursor::evaluate(const std::vector<double>& x, std::vector<double>& out) 
+{
+    return curve_.evaluateBatch(x, out, &CurveInterpolation::_evaluate, &index_);
+}
+
+bool CurveInterpolation::Cursor::evaluateFirstDerivative(const std::vector<double>& x, std::vector<double>& out) 
+{
+    return curve_.evaluateBatch(x, out, &CurveInterpolation::_evaluateFirstDerivative, &index_);
+}
+
+bool CurveInterpolation::Cursor::evaluateSecondDerivative(const std::vector<double>& x, std::vector<double>& out) 
+{
+    return curve_.evaluateBatch(x, out, &CurveInterpolation::_evaluateSecondDerivative, &index_);
+}
 
 std::map<double, double> CurveInterpolation::getInitialData() const 
 {
     std::map<double, double> result;
-    for (std::size_t i = 0; i < xVector_.size(); ++i) {
-        result.emplace(xVector_[i], yVector_[i]);
+    for (int i = 0; i < numberKnots_; ++i) {
+        result.emplace(getX(i), getY(i));
     }
 
     return result;
 }
 
-LinearInterpolation::LinearInterpolation(const std::map<double, double>& data): CurveInterpolation(data){}
+LinearInterpolation::LinearInterpolation(const std::map<double, double>& data): CurveInterpolation(data), borrowedY_(nullptr)
+{
+    yVector_.reserve(data.size());
+    for (auto const& imap: data) {yVector_.push_back(imap.second);}
+    classSetter();
+}
+
+LinearInterpolation::LinearInterpolation(const std::vector<double>& x, const std::vector<double>& y): 
+CurveInterpolation(x, y), yVector_(y), borrowedY_(nullptr){classSetter();}
 
-double LinearInterpolation::_evaluate(double x) const
+LinearInterpolation::LinearInterpolation(const Eigen::Ref<const Eigen::VectorXd>& x, const Eigen::Ref<const Eigen::VectorXd>& y): 
+CurveInterpolation(x, y), yVector_(y.data(), y.data() + y.size()), borrowedY_(nullptr){classSetter();}
+
+LinearInterpolation::LinearInterpolation(const Eigen::Map<const Eigen::VectorXd>& x, const Eigen::Map<const Eigen::VectorXd>& y, const Storage& storage): 
+CurveInterpolation(x, y, storage), borrowedY_(storage == Storage::BORROWED ? y.data() : nullptr)
 {
-    int i = findIndex(x);
-    double x0 = getX(i - 1), x1 = getX(i);
-    double y0 = getY(i - 1), y1 = getY(i);
-    double t = (x - x0) / (x1 - x0);
-    return y0 + t * (y1 - y0);
+    if (storage == Storage::OWNED) yVector_.assign(y.data(), y.data() + y.size());
+    classSetter();
 }
 
-double LinearInterpolation::_evaluateFirstDerivative(double x) const
+void LinearInterpolation::classSetter()
 {
-    int i = findIndex(x);
-    double x0 = getX(i - 1), x1 = getX(i);
-    double y0 = getY(i - 1), y1 = getY(i);
-    return (y1 - y0) / (x1 - x0);
+    const double* x = getKnots();
+    const double* y = getValues();
+    int n = getNumberKnots() - 1;
+    slopes_.resize(n + 1);
+    for (int i = 0; i < n; ++i) {
+        slopes_[i] = (y[i + 1] - y[i]) / (x[i + 1] - x[i]);
+    }
+    // The last knot is its own segment: it carries the slope of the final interval.
+    slopes_[n] = slopes_[n - 1];
+}
+
+double LinearInterpolation::getY(int i) const {return getValues()[i];}
+const double* LinearInterpolation::getValues() const {return borrowedY_ ? borrowedY_ : yVector_.data();}
+
+void LinearInterpolation::_evaluate(const double* x, const int* index, double* out, int n) const
+{
+    const double* xk = getKnots();
+    const double* yk = getValues();
+    const double* s = slopes_.data();
+    for (int k = 0; k < n; ++k) {
+        int i = index[k] - 1;
+        out[k] = CurvePolicy::Linear::value({yk[i], s[i]}, x[k] - xk[i]);
+    }
+}
+
+void LinearInterpolation::_evaluateFirstDerivative(const double*, const int* index, double* out, int n) const
+{
+    const double* s = slopes_.data();
+    for (int k = 0; k < n; ++k) {out[k] = s[index[k] - 1];}
 } 
 
-double LinearInterpolation::_evaluateSecondDerivative(double x) const {return 0.0;} 
+void LinearInterpolation::_evaluateSecondDerivative(const double*, const int*, double* out, int n) const 
+{
+    std::fill(out, out + n, 0.0);
+} 
 
-CubicSpline::CubicSpline(const std::map<double, double>& data): CurveInterpolation(data){classSetter();}
+PiecewiseCubicInterpolation::PiecewiseCubicInterpolation(const std::map<double, double>& data): CurveInterpolation(data)
+{
+    segments_.reserve(data.size());
+    for (auto const& imap: data) {segments_.push_back(Segment{imap.second, 0.0, 0.0, 0.0});}
+}
 
-void CubicSpline::classSetter()
+PiecewiseCubicInterpolation::PiecewiseCubicInterpolation(const std::vector<double>& x, const std::vector<double>& y): CurveInterpolation(x, y)
 {
-    x_ = getVectorX();
-    int n = x_.size() - 1; 
-    a_ = getVectorY();
-    
-    std::vector<double> h(n);
-    std::vector<double> alpha(n, 0.0);
+    classSetter(y.data());
+}
 
+PiecewiseCubicInterpolation::PiecewiseCubicInterpolation(const Eigen::Ref<const Eigen::VectorXd>& x, const Eigen::Ref<const Eigen::VectorXd>& y): 
+CurveInterpolation(x, y)
+{
+    classSetter(y.data());
+}
+
+PiecewiseCubicInterpolation::PiecewiseCubicInterpolation(const Eigen::Map<const Eigen::VectorXd>& x, const Eigen::Map<const Eigen::VectorXd>& y, const Storage& storage): 
+CurveInterpolation(x, y, storage)
+{
+    classSetter(y.data());
+}
+
+void PiecewiseCubicInterpolation::classSetter(const double* y)
+{
+    int n = getNumberKnots();
+    segments_.resize(n);
+    for (int i = 0; i < n; ++i) {segments_[i] = Segment{y[i], 0.0, 0.0, 0.0};}
+}
+
+void PiecewiseCubicInterpolation::setHermiteSlopes(const std::vector<double>& slopes)
+{
+    // Cubic Hermite segments matching the values and the given slopes at both ends.
+    const double* x = getKnots();
+    int n = getNumberKnots() - 1;
+    Segment* s = segments_.data();
     for (int i = 0; i < n; ++i) {
-        h[i] = x_[i + 1] - x_[i];
+        double inverseH = 1.0 / (x[i + 1] - x[i]);
+        double delta = (s[i + 1].a - s[i].a) * inverseH;
+        s[i].b = slopes[i];
+        s[i].c = (3.0 * delta - 2.0 * slopes[i] - slopes[i + 1]) * inverseH;
+        s[i].d = (slopes[i] + slopes[i + 1] - 2.0 * delta) * inverseH * inverseH;
+    }
+    // The last knot is its own segment, holding the left limits of the last cubic.
+    double h = x[n] - x[n - 1];
+    s[n].b = slopes[n];
+    s[n].c = s[n - 1].c + 3.0 * s[n - 1].d * h;
+    s[n].d = 0.0;
+}
+
+double PiecewiseCubicInterpolation::getY(int i) const {return segments_[i].a;}
+
+void PiecewiseCubicInterpolation::_evaluate(const double* x, const int* index, double* out, int n) const
+{
+    const double* xk = getKnots();
+    const Segment* s = segments_.data();
+    for (int k = 0; k < n; ++k) {
+        int i = index[k] - 1;
+        double dx = x[k] - xk[i];
+        out[k] = CurvePolicy::Cubic::value(s[i], dx);
     }
+}
 
+void PiecewiseCubicInterpolation::_evaluateFirstDerivative(const double* x, const int* index, double* out, int n) const
+{
+    const double* xk = getKnots();
+    const Segment* s = segments_.data();
+    for (int k = 0; k < n; ++k) {
+        int i = index[k] - 1;
+        double dx = x[k] - xk[i];
+        out[k] = CurvePolicy::Cubic::firstDerivative(s[i], dx);
+    }
+}
+
+void PiecewiseCubicInterpolation::_evaluateSecondDerivative(const double* x, const int* index, double* out, int n) const
+{
+    const double* xk = getKnots();
+    const Segment* s = segments_.data();
+    for (int k = 0; k < n; ++k) {
+        int i = index[k] - 1;
+        double dx = x[k] - xk[i];
+        out[k] = CurvePolicy::Cubic::secondDerivative(s[i], dx);
+    }
+}
+
+CubicSpline::CubicSpline(const std::map<double, double>& data): PiecewiseCubicInterpolation(data){classSetter();}
+
+CubicSpline::CubicSpline(const std::vector<double>& x, const std::vector<double>& y): PiecewiseCubicInterpolation(x, y){classSetter();}
+
+CubicSpline::CubicSpline(const Eigen::Ref<const Eigen::VectorXd>& x, const Eigen::Ref<const Eigen::VectorXd>& y): PiecewiseCubicInterpolation(x, y){classSetter();}
+
+CubicSpline::CubicSpline(const Eigen::Map<const Eigen::VectorXd>& x, const Eigen::Map<const Eigen::VectorXd>& y, const Storage& storage): 
+PiecewiseCubicInterpolation(x, y, storage){classSetter();}
+
+void CubicSpline::classSetter()
+{
+    // Same arithmetic as factorize() and solve(), without keeping the factorization.
+    CurvePolicy::Cubic::build(getKnots(), segments_.data(), getNumberKnots());
+}
+
+void CubicSpline::factorize(Factorization& factorization) const
+{
+    // LU factorization of the natural spline tridiagonal system, which only depends on the knots.
+    const double* x = getKnots();
+    int n = getNumberKnots() - 1;
+    factorization.inverseH.resize(n);
+    factorization.inverseL.assign(n + 1, 1.0);
+    factorization.mu.assign(n, 0.0);
+    for (int i = 0; i < n; ++i) {factorization.inverseH[i] = 1.0 / (x[i + 1] - x[i]);}
     for (int i = 1; i < n; ++i) {
-        alpha[i] = (3.0 / h[i]) * (a_[i + 1] - a_[i]) - (3.0 / h[i - 1]) * (a_[i] - a_[i - 1]);
+        double l = 2.0 * (x[i + 1] - x[i - 1]) - (x[i] - x[i - 1]) * factorization.mu[i - 1];
+        factorization.inverseL[i] = 1.0 / l;
+        factorization.mu[i] = (x[i + 1] - x[i]) * factorization.inverseL[i];
     }
+}
 
-    std::vector<double> l(n + 1, 0.0);
-    std::vector<double> mu(n, 0.0);
-    std::vector<double> z(n + 1, 0.0);
-    
-    l[0] = 1.0;  
-    mu[0] = 0.0;
-    z[0] = 0.0;
+void CubicSpline::solve(const Factorization& factorization)
+{
+    // Forward substitution stores z in the c coefficients, back substitution then overwrites them in 
+    // place, so that a solve does not allocate.
+    const double* x = getKnots();
+    const double* inverseH = factorization.inverseH.data();
+    const double* inverseL = factorization.inverseL.data();
+    const double* mu = factorization.mu.data();
+    int n = getNumberKnots() - 1;
+    Segment* s = segments_.data();
 
+    s[0].c = 0.0;
     for (int i = 1; i < n; ++i) {
-        l[i] = 2.0 * (x_[i + 1] - x_[i - 1]) - h[i - 1] * mu[i - 1];
-        mu[i] = h[i] / l[i];
-        z[i] = (alpha[i] - h[i - 1] * z[i - 1]) / l[i];
-    }
-
-    l[n] = 1.0;
-    z[n] = 0.0;
-    
-    c_.resize(n + 1, 0.0);
-    b_.resize(n, 0.0);
-    d_.resize(n, 0.0);
-    
+        double alpha = 3.0 * ((s[i + 1].a - s[i].a) * inverseH[i] - (s[i].a - s[i - 1].a) * inverseH[i - 1]);
+        s[i].c = (alpha - (x[i] - x[i - 1]) * s[i - 1].c) * inverseL[i];
+    }
+    s[n].c = 0.0;
+
     for (int j = n - 1; j >= 0; --j) {
-        c_[j] = z[j] - mu[j] * c_[j + 1];
-        b_[j] = (a_[j + 1] - a_[j]) / h[j] - h[j] * (c_[j + 1] + 2.0 * c_[j]) / 3.0;
-        d_[j] = (c_[j + 1] - c_[j]) / (3.0 * h[j]);
+        double h = x[j + 1] - x[j];
+        s[j].c -= mu[j] * s[j + 1].c;
+        s[j].b = (s[j + 1].a - s[j].a) * inverseH[j] - h * (s[j + 1].c + 2.0 * s[j].c) / 3.0;
+        s[j].d = (s[j + 1].c - s[j].c) * inverseH[j] / 3.0;
     }
+
+    // The last knot is its own segment: slope at the right end, natural boundary (c = d = 0).
+    CurvePolicy::Cubic::closeLastSegment(x, s, n + 1);
 }
 
-double CubicSpline::_evaluate(double x) const
+void CubicSpline::updateValue(int index, double y)
 {
-    int i = findIndex(x);
-    double dx = x - getX(i-1);
-    return a_[i-1] + b_[i-1] * dx + c_[i-1] * dx * dx + d_[i-1] * dx * dx * dx;
+    if (index < 0 || index >= static_cast<int>(segments_.size())) throw MathErrorRegistry::CurveInterpolation::InvalidKnotIndexError();
+    if (factorization_.mu.empty()) factorize(factorization_);
+    segments_[index].a = y;
+    solve(factorization_);
 }
 
-double CubicSpline::_evaluateFirstDerivative(double x) const
+void CubicSpline::updateValues(const std::vector<double>& y)
 {
-    int i = findIndex(x);
-    double dx = x - getX(i-1);
-    return b_[i-1] + 2.0*c_[i-1] * dx + 3.0*d_[i-1] * dx * dx;
+    if (y.size() != segments_.size()) throw MathErrorRegistry::CurveInterpolation::MismatchVectorSizeError();
+    if (factorization_.mu.empty()) factorize(factorization_);
+    for (std::size_t i = 0; i < y.size(); ++i) {segments_[i].a = y[i];}
+    solve(factorization_);
 }
 
-double CubicSpline::_evaluateSecondDerivative(double x) const
+bool CubicSpline::evaluateJacobian(const std::vector<double>& x, Eigen::MatrixXd& jacobian) const
 {
-    int i = findIndex(x);
-    double dx = x - getX(i-1);
-    return 2.0*c_[i-1] + 6.0*d_[i-1] * dx;
-}
\ No newline at end of file
+    Factorization local;
+    if (factorization_.mu.empty()) factorize(local);
+    const Factorization& f = factorization_.mu.empty() ? local : factorization_;
+    const double* knots = getKnots();
+    int n = getNumberKnots() - 1;
+
+    // dc/dy: the substitution of solve() applied to every unit right-hand side at once, row by row.
+    Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> C = Eigen::MatrixXd::Zero(n + 1, n + 1);
+    for (int i = 1; i < n; ++i) {
+        C(i, i - 1) = 3.0 * f.inverseH[i - 1];
+        C(i, i) = -3.0 * (f.inverseH[i] + f.inverseH[i - 1]);
+        C(i, i + 1) = 3.0 * f.inverseH[i];
+        C.row(i) = (C.row(i) - (knots[i] - knots[i - 1]) * C.row(i - 1)) * f.inverseL[i];
+    }
+    for (int j = n - 1; j >= 0; --j) {C.row(j) -= f.mu[j] * C.row(j + 1);}
+
+    int m = x.size();
+    jacobian.setZero(m, n + 1);
+    bool inRange = true;
+    for (int j = 0; j < m; ++j) {
+        if (!(x[j] >= getLowerBoundX() && x[j] <= getUpperBoundX())) {
+            jacobian.row(j).setConstant(NAN); 
+            inRange = false; 
+            continue;
+        }
+        int k = findIndex(x[j]) - 1;
+        if (k == n) {jacobian(j, n) = 1.0; continue;}
+        // s = y_k + b_k dx + c_k dx^2 + d_k dx^3 with b_k and d_k written in terms of y_k, y_k+1, c_k and c_k+1
+        double h = knots[k + 1] - knots[k], dx = x[j] - knots[k], t = dx * f.inverseH[k];
+        double weightK = dx * dx - 2.0 * h * dx / 3.0 - dx * dx * t / 3.0;
+        double weightK1 = dx * dx * t / 3.0 - h * dx / 3.0;
+        jacobian.row(j) = weightK * C.row(k) + weightK1 * C.row(k + 1);
+        jacobian(j, k) += 1.0 - t;
+        jacobian(j, k + 1) += t;
+    }
+    return inRange;
+}
+
+MonotoneCubicSpline::MonotoneCubicSpline(const std::map<double, double>& data): PiecewiseCubicInterpolation(data){classSetter();}
+
+MonotoneCubicSpline::MonotoneCubicSpline(const std::vector<double>& x, const std::vector<double>& y): PiecewiseCubicInterpolation(x, y){classSetter();}
+
+MonotoneCubicSpline::MonotoneCubicSpline(const Eigen::Ref<const Eigen::VectorXd>& x, const Eigen::Ref<const Eigen::VectorXd>& y): PiecewiseCubicInterpolation(x, y){classSetter();}
+
+MonotoneCubicSpline::MonotoneCubicSpline(const Eigen::Map<const Eigen::VectorXd>& x, const Eigen::Map<const Eigen::VectorXd>& y, const Storage& storage): 
+PiecewiseCubicInterpolation(x, y, storage){classSetter();}
+
+void MonotoneCubicSpline::classSetter()
+{
+    // Fritsch-Carlson: three-point slopes, set to zero at local extrema and scaled down where they would 
+    // leave the monotonicity region alpha^2 + beta^2 <= 9.
+    const double* x = getKnots();
+    int n = getNumberKnots() - 1;
+    std::vector<double> delta(n), slopes(n + 1);
+    for (int i = 0; i < n; ++i) {delta[i] = (segments_[i + 1].a - segments_[i].a) / (x[i + 1] - x[i]);}
+    slopes[0] = delta[0];
+    slopes[n] = delta[n - 1];
+    for (int i = 1; i < n; ++i) {
+        slopes[i] = (delta[i - 1] * delta[i] <= 0.0) ? 0.0 : 0.5 * (delta[i - 1] + delta[i]);
+    }
+    for (int i = 0; i < n; ++i) {
+        if (delta[i] == 0.0) {slopes[i] = 0.0; slopes[i + 1] = 0.0; continue;}
+        double alpha = slopes[i] / delta[i], beta = slopes[i + 1] / delta[i];
+        double radius = alpha * alpha + beta * beta;
+        if (radius > 9.0) {
+            double tau = 3.0 / std::sqrt(radius);
+            slopes[i] = tau * alpha * delta[i];
+            slopes[i + 1] = tau * beta * delta[i];
+        }
+    }
+    setHermiteSlopes(slopes);
+}
+
+AkimaSpline::AkimaSpline(const std::map<double, double>& data): PiecewiseCubicInterpolation(data){classSetter();}
+
+AkimaSpline::AkimaSpline(const std::vector<double>& x, const std::vector<double>& y): PiecewiseCubicInterpolation(x, y){classSetter();}
+
+AkimaSpline::AkimaSpline(const Eigen::Ref<const Eigen::VectorXd>& x, const Eigen::Ref<const Eigen::VectorXd>& y): PiecewiseCubicInterpolation(x, y){classSetter();}
+
+AkimaSpline::AkimaSpline(const Eigen::Map<const Eigen::VectorXd>& x, const Eigen::Map<const Eigen::VectorXd>& y, const Storage& storage): 
+PiecewiseCubicInterpolation(x, y, storage){classSetter();}
+
+void AkimaSpline::classSetter()
+{
+    // Segment slopes padded with two linearly extrapolated slopes on each side: delta[i + 2] is the slope 
+    // of segment i. The knot slope weighs its two neighbouring segment slopes by the variation on the 
+    // opposite side, which avoids the overshoot of the natural spline near outliers.
+    const double* x = getKnots();
+    int n = getNumberKnots() - 1;
+    std::vector<double> delta(n + 4), slopes(n + 1);
+    for (int i = 0; i < n; ++i) {delta[i + 2] = (segments_[i + 1].a - segments_[i].a) / (x[i + 1] - x[i]);}
+    if (n == 1) {
+        std::fill(slopes.begin(), slopes.end(), delta[2]);
+        setHermiteSlopes(slopes);
+        return;
+    }
+    delta[1] = 2.0 * delta[2] - delta[3];
+    delta[0] = 2.0 * delta[1] - delta[2];
+    delta[n + 2] = 2.0 * delta[n + 1] - delta[n];
+    delta[n + 3] = 2.0 * delta[n + 2] - delta[n + 1];
+    for (int i = 0; i <= n; ++i) {
+        double left = std::abs(delta[i + 1] - delta[i]), right = std::abs(delta[i + 3] - delta[i + 2]);
+        slopes[i] = (left + right == 0.0) ? 0.5 * (delta[i + 1] + delta[i + 2]) : (right * delta[i + 1] + left * delta[i + 2]) / (left + right);
+    }
+    setHermiteSlopes(slopes);
+}
+
+LogLinearInterpolation::LogLinearInterpolation(const std::map<double, double>& data): CurveInterpolation(data)
+{
+    yVector_.reserve(data.size());
+    for (auto const& imap: data) {yVector_.push_back(imap.second);}
+    classSetter();
+}
+
+LogLinearInterpolation::LogLinearInterpolation(const std::vector<double>& x, const std::vector<double>& y): 
+CurveInterpolation(x, y), yVector_(y){classSetter();}
+
+LogLinearInterpolation::LogLinearInterpolation(const Eigen::Ref<const Eigen::VectorXd>& x, const Eigen::Ref<const Eigen::VectorXd>& y): 
+CurveInterpolation(x, y), yVector_(y.data(), y.data() + y.size()){classSetter();}
+
+LogLinearInterpolation::LogLinearInterpolation(const Eigen::Map<const Eigen::VectorXd>& x, const Eigen::Map<const Eigen::VectorXd>& y, const Storage& storage): 
+CurveInterpolation(x, y, storage), yVector_(y.data(), y.data() + y.size()){classSetter();}
+
+void LogLinearInterpolation::classSetter()
+{
+    const double* x = getKnots();
+    int n = getNumberKnots() - 1;
+    logValues_.resize(n + 1);
+    slopes_.resize(n + 1);
+    for (int i = 0; i <= n; ++i) {
+        if (!(yVector_[i] > 0.0)) throw MathErrorRegistry::CurveInterpolation::NonPositiveValueError();
+        logValues_[i] = std::log(yVector_[i]);
+    }
+    for (int i = 0; i < n; ++i) {slopes_[i] = (logValues_[i + 1] - logValues_[i]) / (x[i + 1] - x[i]);}
+    slopes_[n] = slopes_[n - 1];
+}
+
+double LogLinearInterpolation::getY(int i) const {return yVector_[i];}
+
+void LogLinearInterpolation::_evaluate(const double* x, const int* index, double* out, int n) const
+{
+    const double* xk = getKnots();
+    const double* logY = logValues_.data();
+    const double* s = slopes_.data();
+    for (int k = 0; k < n; ++k) {
+        int i = index[k] - 1;
+        out[k] = std::exp(logY[i] + (x[k] - xk[i]) * s[i]);
+    }
+}
+
+void LogLinearInterpolation::_evaluateFirstDerivative(const double* x, const int* index, double* out, int n) const
+{
+    _evaluate(x, index, out, n);
+    const double* s = slopes_.data();
+    for (int k = 0; k < n; ++k) {out[k] *= s[index[k] - 1];}
+}
+
+void LogLinearInterpolation::_evaluateSecondDerivative(const double* x, const int* index, double* out, int n) const
+{
+    _evaluate(x, index, out, n);
+    const double* s = slopes_.data();
+    for (int k = 0; k < n; ++k) {
+        double slope = s[index[k] - 1];
+        out[k] *= slope * slope;
+    }
+}
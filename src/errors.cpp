@@ -14,11 +14,17 @@ namespace MathErrorRegistry
     {
         std::string WrongVectorSizeError::getErrorMessage() const {return "The data must have a size greater than 3 to construct interpolation object.";}
         std::string OutOfRangeCurveInterpolationError::getErrorMessage() const {return "Cannot interpolate a value out of interpolatin range.";}
+        std::string InvalidKnotIndexError::getErrorMessage() const {return "The knot index is out of the range of the interpolation data.";}
+        std::string MismatchVectorSizeError::getErrorMessage() const {return "The number of values must match the number of knots of the interpolation.";}
+        std::string UnsortedKnotsError::getErrorMessage() const {return "The knots of the interpolation must be strictly increasing.";}
+        std::string NonPositiveValueError::getErrorMessage() const {return "The values of a log-linear interpolation must be strictly positive.";}
     };
 
     namespace Optim
     {
         std::string NewtonRaphsonDerivativeZeroError::getErrorMessage() const {return "The derivative value in the Newton-Raphson optimizer is getting close to zero which makes the optimizer unstable.";}
+        std::string InvalidBracketError::getErrorMessage() const {return "The bracket [a, b] is invalid: a < b and a sign change of the function between a and b are required.";}
+        std::string LineSearchError::getErrorMessage() const {return "The line search found no sufficient decrease along the search direction (e.g. an inaccurate gradient).";}
     };
 
     namespace Probability
@@ -42,4 +48,16 @@ namespace MathErrorRegistry
     {
         std::string MismatchTargetFeaturesSizeError::getErrorMessage() const {return "The number of rows in the matrix of features must match the number of targets.";}
     }
+
+    namespace FiniteDifference
+    {
+        std::string MismatchOutputSizeError::getErrorMessage() const {return "The gradient must have one entry per variable, and the Jacobian one row per function value and one column per variable.";}
+        std::string ComplexStepFunctionError::getErrorMessage() const {return "The complex-step method needs a function of complex arguments.";}
+    }
+
+    namespace Quadrature
+    {
+        std::string InvalidLaguerreAlphaError::getErrorMessage() const {return "The generalized Laguerre parameter alpha must be greater than -1.";}
+        std::string UnsupportedKronrodRuleError::getErrorMessage() const {return "Gauss-Kronrod rules are available for 7 (G7K15) and 10 (G10K21) Gauss points.";}
+    }
 }
\ No newline at end of file
@@ -0,0 +1,199 @@
+#include "../include/core-math/finitedifference.hpp"
+
+FiniteDifference::FiniteDifference(const Method& method, int numberThreads): method_(method), step_(NAN), numberEvaluations_(0)
+{
+    if (numberThreads != 1) pool_ = std::make_shared<ThreadPool>(numberThreads);
+}
+
+void FiniteDifference::setMethod(const Method& method){method_ = method;}
+void FiniteDifference::setStep(double step){step_ = step;}
+
+FiniteDifference::Method FiniteDifference::getMethod() const{return method_;}
+int FiniteDifference::getNumberThreads() const{return pool_ ? pool_->getNumberThreads() : 1;}
+int FiniteDifference::getNumberEvaluations() const{return numberEvaluations_;}
+
+double FiniteDifference::getStep() const
+{
+    if (!std::isnan(step_)) return step_;
+    switch (method_) {
+        case Method::FORWARD: return std::sqrt(std::numeric_limits<double>::epsilon());
+        case Method::CENTRAL: return std::cbrt(std::numeric_limits<double>::epsilon());
+        default: return 1e-20;
+    }
+}
+
+double FiniteDifference::getStepSize(double x) const
+{
+    double h = getStep() * (1.0 + std::abs(x));
+    // Real steps are rounded to a representable x + h, so that the quotient divides by the actual step.
+    return method_ == Method::COMPLEX_STEP ? h : (x + h) - x;
+}
+
+int FiniteDifference::getNumberChunks(int n) const{return std::max(1, std::min(getNumberThreads(), n));}
+
+void FiniteDifference::setBuffers(int n, int m, bool complex)
+{
+    std::size_t chunks = getNumberChunks(n);
+    if (complex) {
+        complexPoints_.resize(chunks);
+        complexValues_.resize(chunks);
+        for (std::size_t c = 0; c < chunks; ++c) {complexPoints_[c].resize(n); complexValues_[c].resize(m);}
+    } else {
+        points_.resize(chunks);
+        up_.resize(chunks);
+        down_.resize(chunks);
+        for (std::size_t c = 0; c < chunks; ++c) {points_[c].resize(n); up_[c].resize(m); down_[c].resize(m);}
+    }
+    values_.resize(m);
+}
+
+void FiniteDifference::gradient(const Function& f, const Eigen::Ref<const Eigen::VectorXd>& x, Eigen::Ref<Eigen::VectorXd> gradient)
+{
+    double fx = method_ == Method::FORWARD ? f(x) : NAN;
+    this->gradient(f, x, fx, gradient);
+    if (method_ == Method::FORWARD) numberEvaluations_++;
+}
+
+void FiniteDifference::gradient(const Function& f, const Eigen::Ref<const Eigen::VectorXd>& x, double fx, Eigen::Ref<Eigen::VectorXd> gradient)
+{
+    if (method_ == Method::COMPLEX_STEP) throw MathErrorRegistry::FiniteDifference::ComplexStepFunctionError();
+    int n = x.size();
+    if (gradient.size() != n) throw MathErrorRegistry::FiniteDifference::MismatchOutputSizeError();
+    setBuffers(n, 0, false);
+    bool central = method_ == Method::CENTRAL;
+    run(n, [&](int c, int begin, int end) {
+        Eigen::VectorXd& point = points_[c];
+        point = x;
+        for (int j = begin; j < end; ++j) {
+            double h = getStepSize(x[j]);
+            point[j] = x[j] + h;
+            double up = f(point);
+            if (central) {
+                point[j] = x[j] - h;
+                gradient[j] = (up - f(point)) / (2.0 * h);
+            } else {
+                gradient[j] = (up - fx) / h;
+            }
+            point[j] = x[j];
+        }
+    });
+    numberEvaluations_ = central ? 2 * n : n;
+}
+
+void FiniteDifference::gradient(const ComplexFunction& f, const Eigen::Ref<const Eigen::VectorXd>& x, Eigen::Ref<Eigen::VectorXd> gradient)
+{
+    int n = x.size();
+    if (gradient.size() != n) throw MathErrorRegistry::FiniteDifference::MismatchOutputSizeError();
+    setBuffers(n, 0, true);
+    double fx = NAN;
+    if (method_ == Method::FORWARD) {
+        complexPoints_[0] = x.cast<std::complex<double>>();
+        fx = f(complexPoints_[0]).real();
+    }
+    run(n, [&](int c, int begin, int end) {
+        Eigen::VectorXcd& point = complexPoints_[c];
+        point = x.cast<std::complex<double>>();
+        for (int j = begin; j < end; ++j) {
+            double h = getStepSize(x[j]);
+            switch (method_) {
+                case Method::COMPLEX_STEP:
+                    // f(x + ih e_j) = f(x) + ih df/dx_j + O(h^2): no cancellation, so h can be tiny.
+                    point[j] = std::complex<double>(x[j], h);
+                    gradient[j] = f(point).imag() / h;
+                    break;
+                case Method::CENTRAL: {
+                    point[j] = x[j] + h;
+                    double up = f(point).real();
+                    point[j] = x[j] - h;
+                    gradient[j] = (up - f(point).real()) / (2.0 * h);
+                    break;
+                }
+                case Method::FORWARD:
+                    point[j] = x[j] + h;
+                    gradient[j] = (f(point).real() - fx) / h;
+                    break;
+            }
+            point[j] = x[j];
+        }
+    });
+    numberEvaluations_ = method_ == Method::CENTRAL ? 2 * n : method_ == Method::FORWARD ? n + 1 : n;
+}
+
+void FiniteDifference::jacobian(const VectorFunction& f, const Eigen::Ref<const Eigen::VectorXd>& x, Eigen::Ref<Eigen::MatrixXd> jacobian)
+{
+    if (method_ == Method::FORWARD) {
+        values_.resize(jacobian.rows());
+        f(x, values_);
+    }
+    this->jacobian(f, x, values_, jacobian);
+    if (method_ == Method::FORWARD) numberEvaluations_++;
+}
+
+void FiniteDifference::jacobian(const VectorFunction& f, const Eigen::Ref<const Eigen::VectorXd>& x, const Eigen::Ref<const Eigen::VectorXd>& fx, Eigen::Ref<Eigen::MatrixXd> jacobian)
+{
+    if (method_ == Method::COMPLEX_STEP) throw MathErrorRegistry::FiniteDifference::ComplexStepFunctionError();
+    int n = x.size(), m = jacobian.rows();
+    bool central = method_ == Method::CENTRAL;
+    if (jacobian.cols() != n || (!central && fx.size() != m)) throw MathErrorRegistry::FiniteDifference::MismatchOutputSizeError();
+    setBuffers(n, m, false);
+    run(n, [&](int c, int begin, int end) {
+        Eigen::VectorXd& point = points_[c];
+        point = x;
+        for (int j = begin; j < end; ++j) {
+            double h = getStepSize(x[j]);
+            point[j] = x[j] + h;
+            f(point, up_[c]);
+            if (central) {
+                point[j] = x[j] - h;
+                f(point, down_[c]);
+                jacobian.col(j) = (up_[c] - down_[c]) / (2.0 * h);
+            } else {
+                jacobian.col(j) = (up_[c] - fx) / h;
+            }
+            point[j] = x[j];
+        }
+    });
+    numberEvaluations_ = central ? 2 * n : n;
+}
+
+void FiniteDifference::jacobian(const ComplexVectorFunction& f, const Eigen::Ref<const Eigen::VectorXd>& x, Eigen::Ref<Eigen::MatrixXd> jacobian)
+{
+    int n = x.size(), m = jacobian.rows();
+    if (jacobian.cols() != n) throw MathErrorRegistry::FiniteDifference::MismatchOutputSizeError();
+    setBuffers(n, m, true);
+    if (method_ == Method::FORWARD) {
+        complexPoints_[0] = x.cast<std::complex<double>>();
+        f(complexPoints_[0], complexValues_[0]);
+        values_ = complexValues_[0].real();
+    }
+    run(n, [&](int c, int begin, int end) {
+        Eigen::VectorXcd& point = complexPoints_[c];
+        Eigen::VectorXcd& values = complexValues_[c];
+        point = x.cast<std::complex<double>>();
+        for (int j = begin; j < end; ++j) {
+            double h = getStepSize(x[j]);
+            switch (method_) {
+                case Method::COMPLEX_STEP:
+                    point[j] = std::complex<double>(x[j], h);
+                    f(point, values);
+                    jacobian.col(j) = values.imag() / h;
+                    break;
+                case Method::CENTRAL:
+                    point[j] = x[j] + h;
+                    f(point, values);
+                    jacobian.col(j) = values.real();
+                    point[j] = x[j] - h;
+                    f(point, values);
+                    jacobian.col(j) = (jacobian.col(j) - values.real()) / (2.0 * h);
+                    break;
+                case Method::FORWARD:
+                    point[j] = x[j] + h;
+                    f(point, values);
+                    jacobian.col(j) = (values.real() - values_) / h;
+                    break;
+            }
+            point[j] = x[j];
+        }
+    });
+    numberEvaluations_ = method_ == Method::CENTRAL ? 2 * n : method_ == Method::FORWARD ? n + 1 : n;
+}
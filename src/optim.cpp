@@ -1,10 +1,85 @@
 #include "../include/core-math/optim.hpp"
 
-Optimizer::Optimizer(): optimized_(false), toleranceThreshold_(1e-9), maximumIterations_(100), timeTaken_(0.0), optimizeError(nullptr){};
+OptimizerTrace::OptimizerTrace(std::size_t capacity, const Callback& callback): records_(capacity), head_(0), size_(0), dropped_(0), 
+callback_(callback){};
+
+void OptimizerTrace::record(const Record& record)
+{
+    if (callback_) callback_(record);
+    if (records_.empty()) return;
+    records_[head_] = record;
+    head_ = (head_ + 1) % records_.size();
+    if (size_ < records_.size()) size_++;
+    else dropped_++;
+}
+
+void OptimizerTrace::clear(){head_ = 0; size_ = 0; dropped_ = 0;}
+std::size_t OptimizerTrace::getCapacity() const{return records_.size();}
+std::size_t OptimizerTrace::getSize() const{return size_;}
+std::size_t OptimizerTrace::getNumberDropped() const{return dropped_;}
+
+std::vector<OptimizerTrace::Record> OptimizerTrace::getRecords() const
+{
+    std::vector<Record> records;
+    records.reserve(size_);
+    std::size_t first = (head_ + records_.size() - size_) % std::max<std::size_t>(records_.size(), 1);
+    for (std::size_t k = 0; k < size_; ++k) {records.push_back(records_[(first + k) % records_.size()]);}
+    return records;
+}
+
+std::string OptimizerTrace::getStepName(const Step& step)
+{
+    switch (step) {
+        case Step::INITIAL: return "initial";
+        case Step::REFLECT: return "reflect";
+        case Step::EXPAND: return "expand";
+        case Step::CONTRACT: return "contract";
+        case Step::SHRINK: return "shrink";
+        case Step::LINE_SEARCH: return "line_search";
+        case Step::DAMPED: return "damped";
+        default: return "rejected";
+    }
+}
+
+void OptimizerTrace::writeCSV(std::ostream& out) const
+{
+    std::streamsize precision = out.precision(17);
+    out << "iteration,step,best_value,diameter,evaluations,evaluation_time,elapsed_time\n";
+    for (const Record& r : getRecords()) {
+        out << r.iteration << ',' << getStepName(r.step) << ',' << r.bestValue << ',' << r.diameter << ',' << r.numberEvaluations 
+        << ',' << r.evaluationTime << ',' << r.elapsedTime << '\n';
+    }
+    out.precision(precision);
+}
+
+void OptimizerTrace::writeJSON(std::ostream& out) const
+{
+    // JSON has no NaN or infinity: non-finite values are written as null.
+    auto number = [&out](double value) -> std::ostream& {return std::isfinite(value) ? out << value : out << "null";};
+    std::streamsize precision = out.precision(17);
+    std::vector<Record> records = getRecords();
+    out << '[';
+    for (std::size_t k = 0; k < records.size(); ++k) {
+        const Record& r = records[k];
+        out << (k ? ",\n" : "\n") << "  {\"iteration\": " << r.iteration << ", \"step\": \"" << getStepName(r.step) << "\", \"best_value\": ";
+        number(r.bestValue) << ", \"diameter\": ";
+        number(r.diameter) << ", \"evaluations\": " << r.numberEvaluations << ", \"evaluation_time\": " << r.evaluationTime 
+        << ", \"elapsed_time\": " << r.elapsedTime << '}';
+    }
+    out << (records.empty() ? "]\n" : "\n]\n");
+    out.precision(precision);
+}
+
+Optimizer::Optimizer(): optimized_(false), interrupted_(false), toleranceThreshold_(1e-9), maximumIterations_(100), timeTaken_(0.0), optimizeError(nullptr), 
+cancellationFlag_(nullptr), trace_(nullptr), evaluationTime_(0.0){};
 
 void Optimizer::optimize()
 {
+    if (optimized_ && !(interrupted_ && !isCancelled())) return;
+    optimizeError = nullptr;
     auto start = std::chrono::high_resolution_clock::now();
+    startTime_ = start;
+    evaluationTime_ = 0.0;
     try{
         _optimize();
     } catch (const std::exception& e){
@@ -13,24 +88,44 @@ void Optimizer::optimize()
     
     auto end = std::chrono::high_resolution_clock::now();
     optimized_ = true;
+    // A cancelled run may have stopped before converging.
+    interrupted_ = isCancelled();
     std::chrono::duration<double> elapsed = end - start;
     timeTaken_ = elapsed.count();
 }
 
 void Optimizer::setOptimized(bool value){optimized_ = value;}
-bool Optimizer::isOptimized() const{return optimized_;}
+bool Optimizer::isOptimized() const{return optimized_ && !interrupted_;}
 double Optimizer::getToleranceThreshold() const{return toleranceThreshold_;}
 int Optimizer::getMaximumIterations() const{return maximumIterations_;}
 double Optimizer::getTimeTaken() const{return timeTaken_;}
 std::exception_ptr Optimizer::getError() const{return optimizeError;}
 void Optimizer::setToleranceThreshold(double value){toleranceThreshold_ = value; optimized_ = false; }
 void Optimizer::setMaximumIterations(int value){maximumIterations_ = value; optimized_ = false;}
+void Optimizer::setCancellationFlag(const std::atomic<bool>* flag){cancellationFlag_ = flag;}
+bool Optimizer::isCancelled() const{return cancellationFlag_ && cancellationFlag_->load(std::memory_order_relaxed);}
+void Optimizer::setTrace(OptimizerTrace* trace){trace_ = trace;}
+OptimizerTrace* Optimizer::getTrace() const{return trace_;}
+
+void Optimizer::addEvaluationTime(const std::chrono::high_resolution_clock::time_point& start)
+{
+    evaluationTime_ += std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+void Optimizer::traceIteration(int iteration, const OptimizerTrace::Step& step, double bestValue, double diameter, int numberEvaluations)
+{
+    if (!trace_) return;
+    double elapsed = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - startTime_).count();
+    trace_->record(OptimizerTrace::Record{iteration, step, bestValue, diameter, numberEvaluations, evaluationTime_, elapsed});
+    evaluationTime_ = 0.0;
+}
 
 NewtonRaphson::NewtonRaphson(double x0, const std::function<double(double)>& f, const std::function<double(double)>& fDeriv): x0_(x0), f_(f), fDeriv_(fDeriv){};
 
 double NewtonRaphson::getResult(){optimize(); return getError() ? NAN : result_;}
 double NewtonRaphson::getFunctionResult(){optimize(); return getError() ? NAN : fResult_;}
 int NewtonRaphson::getNumberIterations(){optimize(); return numberIterations_;}
+double NewtonRaphson::getObjectiveValue(){optimize(); return getError() ? NAN : std::abs(fResult_);}
 double NewtonRaphson::getStartValue() const{return x0_;}
 double NewtonRaphson::evaluateFunction(double value) const{return f_(value);}
 double NewtonRaphson::evaluateFunctionDerivative(double value) const{return fDeriv_(value);}
@@ -48,7 +143,7 @@ void NewtonRaphson::_optimize()
         numberIterations_ += 1;
         fX = f_(x);
         dfX = fDeriv_(x);
-        if (std::abs(fX) < getToleranceThreshold()){
+        if (std::abs(fX) < getToleranceThreshold() || isCancelled()){
             break;
         }
         
@@ -66,6 +161,258 @@ void NewtonRaphson::_optimize()
     fResult_ = fX; 
 }
 
+BracketedRootFinder::BracketedRootFinder(double a, double b, const std::function<double(double)>& f): 
+numberIterations_(0), a_(a), b_(b), f_(f), result_(NAN), fResult_(NAN), numberEvaluations_(0){};
+
+double BracketedRootFinder::getResult(){optimize(); return getError() ? NAN : result_;}
+double BracketedRootFinder::getFunctionResult(){optimize(); return getError() ? NAN : fResult_;}
+int BracketedRootFinder::getNumberIterations(){optimize(); return numberIterations_;}
+double BracketedRootFinder::getObjectiveValue(){optimize(); return getError() ? NAN : std::abs(fResult_);}
+int BracketedRootFinder::getNumberEvaluations(){optimize(); return numberEvaluations_;}
+double BracketedRootFinder::getLowerBound() const{return a_;}
+double BracketedRootFinder::getUpperBound() const{return b_;}
+void BracketedRootFinder::setBracket(double a, double b){a_ = a; b_ = b; setOptimized(false);}
+void BracketedRootFinder::countEvaluation(){numberEvaluations_++;}
+double BracketedRootFinder::evaluateFunction(double x){numberEvaluations_++; return f_(x);}
+void BracketedRootFinder::setRoot(double x, double fX){result_ = x; fResult_ = fX;}
+
+void BracketedRootFinder::checkBracket(double& fa, double& fb)
+{
+    numberEvaluations_ = 0;
+    numberIterations_ = 0;
+    if (!(a_ < b_)) throw MathErrorRegistry::Optim::InvalidBracketError();
+    fa = evaluateFunction(a_);
+    fb = evaluateFunction(b_);
+    if (!(fa * fb <= 0.0)) throw MathErrorRegistry::Optim::InvalidBracketError();
+}
+
+void BracketedRootFinder::solveSafeguarded(double x0, const std::function<double(double, double)>& step)
+{
+    double fa, fb;
+    checkBracket(fa, fb);
+    if (fa == 0.0) {setRoot(a_, fa); return;}
+    if (fb == 0.0) {setRoot(b_, fb); return;}
+    // Ends of the current bracket where f is negative and positive.
+    double low = fa < 0.0 ? a_ : b_;
+    double high = fa < 0.0 ? b_ : a_;
+    double x = (x0 > a_ && x0 < b_) ? x0 : 0.5 * (a_ + b_);
+    double fX = evaluateFunction(x);
+    double dx = b_ - a_, dxOld = dx;
+    for (int i = 1; i <= getMaximumIterations(); ++i) {
+        numberIterations_ = i;
+        if (std::abs(fX) < getToleranceThreshold() || isCancelled()) break;
+        if (fX < 0.0) low = x; else high = x;
+        double delta = step(x, fX);
+        double xNew = x - delta;
+        bool inside = (xNew - low) * (xNew - high) < 0.0;
+        if (!std::isfinite(xNew) || !inside || std::abs(delta) > 0.5 * std::abs(dxOld)) xNew = 0.5 * (low + high);
+        dxOld = dx;
+        dx = xNew - x;
+        x = xNew;
+        fX = evaluateFunction(x);
+        if (std::abs(dx) < getToleranceThreshold()) break;
+    }
+    setRoot(x, fX);
+}
+
+Brent::Brent(double a, double b, const std::function<double(double)>& f): BracketedRootFinder(a, b, f){};
+
+void Brent::_optimize()
+{
+    // Brent (1973): b is the best estimate, [b, c] the bracket and a the previous estimate.
+    double fa, fb;
+    checkBracket(fa, fb);
+    double a = getLowerBound(), b = getUpperBound();
+    double c = b, fc = fb, d = b - a, e = d;
+    for (int i = 1; i <= getMaximumIterations(); ++i) {
+        numberIterations_ = i;
+        if ((fb > 0.0 && fc > 0.0) || (fb < 0.0 && fc < 0.0)) {c = a; fc = fa; e = d = b - a;}
+        if (std::abs(fc) < std::abs(fb)) {a = b; b = c; c = a; fa = fb; fb = fc; fc = fa;}
+        double tolerance = 2.0 * std::numeric_limits<double>::epsilon() * std::abs(b) + 0.5 * getToleranceThreshold();
+        double middle = 0.5 * (c - b);
+        if (std::abs(middle) <= tolerance || std::abs(fb) < getToleranceThreshold() || isCancelled()) break;
+        if (std::abs(e) >= tolerance && std::abs(fa) > std::abs(fb)) {
+            // Inverse quadratic interpolation, or secant when only two points are distinct.
+            double s = fb / fa, p, q;
+            if (a == c) {
+                p = 2.0 * middle * s;
+                q = 1.0 - s;
+            } else {
+                double r = fb / fc;
+                q = fa / fc;
+                p = s * (2.0 * middle * q * (q - r) - (b - a) * (r - 1.0));
+                q = (q - 1.0) * (r - 1.0) * (s - 1.0);
+            }
+            if (p > 0.0) q = -q;
+            p = std::abs(p);
+            if (2.0 * p < std::min(3.0 * middle * q - std::abs(tolerance * q), std::abs(e * q))) {e = d; d = p / q;}
+            else {d = middle; e = d;}
+        } else {
+            d = middle; 
+            e = d;
+        }
+        a = b;
+        fa = fb;
+        b += std::abs(d) > tolerance ? d : (middle > 0.0 ? tolerance : -tolerance);
+        fb = evaluateFunction(b);
+    }
+    setRoot(b, fb);
+}
+
+NewtonBisection::NewtonBisection(double a, double b, const std::function<double(double)>& f, const std::function<double(double)>& fDeriv): 
+BracketedRootFinder(a, b, f), fDeriv_(fDeriv), x0_(NAN){};
+
+void NewtonBisection::setStartValue(double x0){x0_ = x0; setOptimized(false);}
+double NewtonBisection::getStartValue() const{return std::isnan(x0_) ? 0.5 * (getLowerBound() + getUpperBound()) : x0_;}
+
+void NewtonBisection::_optimize()
+{
+    solveSafeguarded(getStartValue(), [this](double x, double fX) {
+        countEvaluation();
+        return fX / fDeriv_(x);
+    });
+}
+
+Halley::Halley(double a, double b, const std::function<double(double)>& f, const std::function<double(double)>& fDeriv, const std::function<double(double)>& fSecondDeriv): 
+BracketedRootFinder(a, b, f), fDeriv_(fDeriv), fSecondDeriv_(fSecondDeriv), x0_(NAN){};
+
+void Halley::setStartValue(double x0){x0_ = x0; setOptimized(false);}
+double Halley::getStartValue() const{return std::isnan(x0_) ? 0.5 * (getLowerBound() + getUpperBound()) : x0_;}
+
+void Halley::_optimize()
+{
+    solveSafeguarded(getStartValue(), [this](double x, double fX) {
+        countEvaluation();
+        countEvaluation();
+        double dfX = fDeriv_(x), d2fX = fSecondDeriv_(x);
+        return 2.0 * fX * dfX / (2.0 * dfX * dfX - fX * d2fX);
+    });
+}
+
+EvaluationCache::EvaluationCache(int dimension, std::size_t capacity){reset(dimension, capacity);}
+
+void EvaluationCache::reset(int dimension, std::size_t capacity)
+{
+    n_ = dimension;
+    capacity_ = capacity;
+    points_.assign(capacity * dimension, 0.0);
+    values_.assign(capacity, 0.0);
+    hashes_.assign(capacity, 0);
+    previous_.assign(capacity, -1);
+    next_.assign(capacity, -1);
+    // Table at most half full, so that probe sequences stay short.
+    std::size_t tableSize = 1;
+    while (tableSize < 2 * capacity) tableSize *= 2;
+    table_.assign(capacity ? tableSize : 0, -1);
+    mask_ = tableSize - 1;
+    clear();
+}
+
+void EvaluationCache::clear()
+{
+    std::fill(table_.begin(), table_.end(), -1);
+    size_ = 0;
+    head_ = -1;
+    tail_ = -1;
+    resetCounters();
+}
+
+void EvaluationCache::resetCounters(){hits_ = 0; misses_ = 0;}
+int EvaluationCache::getDimension() const{return n_;}
+std::size_t EvaluationCache::getCapacity() const{return capacity_;}
+std::size_t EvaluationCache::getSize() const{return size_;}
+long long EvaluationCache::getHits() const{return hits_;}
+long long EvaluationCache::getMisses() const{return misses_;}
+
+std::size_t EvaluationCache::hash(const double* x) const
+{
+    // FNV-1a over the 64-bit patterns of the coordinates.
+    std::uint64_t h = 14695981039346656037ull;
+    for (int j = 0; j < n_; ++j) {
+        std::uint64_t bits;
+        std::memcpy(&bits, x + j, sizeof(bits));
+        h = (h ^ bits) * 1099511628211ull;
+    }
+    return static_cast<std::size_t>(h ^ (h >> 32));
+}
+
+bool EvaluationCache::isEqual(int slot, const double* x) const
+{
+    return std::memcmp(points_.data() + static_cast<std::size_t>(slot) * n_, x, n_ * sizeof(double)) == 0;
+}
+
+int EvaluationCache::findPosition(const double* x, std::size_t h) const
+{
+    for (std::size_t position = h & mask_; ; position = (position + 1) & mask_) {
+        int slot = table_[position];
+        if (slot < 0) return -1;
+        if (hashes_[slot] == h && isEqual(slot, x)) return position;
+    }
+}
+
+void EvaluationCache::erasePosition(std::size_t position)
+{
+    // Backward-shift deletion: entries after the hole move back if the hole lies on their probe sequence.
+    std::size_t j = position;
+    while (true) {
+        j = (j + 1) & mask_;
+        if (table_[j] < 0) break;
+        std::size_t ideal = hashes_[table_[j]] & mask_;
+        if (((j - ideal) & mask_) >= ((j - position) & mask_)) {
+            table_[position] = table_[j];
+            position = j;
+        }
+    }
+    table_[position] = -1;
+}
+
+void EvaluationCache::unlink(int slot)
+{
+    if (previous_[slot] >= 0) next_[previous_[slot]] = next_[slot]; else head_ = next_[slot];
+    if (next_[slot] >= 0) previous_[next_[slot]] = previous_[slot]; else tail_ = previous_[slot];
+}
+
+void EvaluationCache::pushFront(int slot)
+{
+    previous_[slot] = -1;
+    next_[slot] = head_;
+    if (head_ >= 0) previous_[head_] = slot; else tail_ = slot;
+    head_ = slot;
+}
+
+bool EvaluationCache::find(const double* x, double& value)
+{
+    if (capacity_ == 0) return false;
+    int position = findPosition(x, hash(x));
+    if (position < 0) {misses_++; return false;}
+    int slot = table_[position];
+    value = values_[slot];
+    if (slot != head_) {unlink(slot); pushFront(slot);}
+    hits_++;
+    return true;
+}
+
+void EvaluationCache::insert(const double* x, double value)
+{
+    if (capacity_ == 0) return;
+    int slot;
+    if (size_ < capacity_) {
+        slot = size_++;
+    } else {
+        slot = tail_;
+        erasePosition(findPosition(points_.data() + static_cast<std::size_t>(slot) * n_, hashes_[slot]));
+        unlink(slot);
+    }
+    std::size_t h = hash(x);
+    std::copy(x, x + n_, points_.begin() + static_cast<std::size_t>(slot) * n_);
+    values_[slot] = value;
+    hashes_[slot] = h;
+    std::size_t position = h & mask_;
+    while (table_[position] >= 0) position = (position + 1) & mask_;
+    table_[position] = slot;
+    pushFront(slot);
+}
+
 void NelderMead::setStartValues(std::vector<double> x0){x0_ = x0; setOptimized(false);}
 void NelderMead::setInitSimplexMethod(const NelderMead::InitSimplexMethod& method){initSimplexMethod_=method;setOptimized(false);}
 void NelderMead::setPerturbationParam(double epsilon){epsilon_=epsilon;setOptimized(false);}
@@ -73,6 +420,13 @@ void NelderMead::setReflectionParam(double alpha){alpha_=alpha;setOptimized(fals
 void NelderMead::setExpansionParam(double beta){beta_=beta;setOptimized(false);}
 void NelderMead::setContractionParam(double gamma){gamma_=gamma;setOptimized(false);}
 void NelderMead::setShrinkParam(double delta){delta_=delta;setOptimized(false);}
+void NelderMead::setCacheCapacity(std::size_t capacity){cacheCapacity_=capacity;setOptimized(false);}
+void NelderMead::setNumberThreads(int numberThreads)
+{
+    pool_ = numberThreads == 1 ? nullptr : std::make_shared<ThreadPool>(numberThreads);
+    setOptimized(false);
+}
+void NelderMead::setNumberDirections(int p){numberDirections_=std::max(1, p);setOptimized(false);}
 
 std::vector<double> NelderMead::getStartValues() const{return x0_;}
 NelderMead::InitSimplexMethod NelderMead::getInitSimplexMethod()const{return initSimplexMethod_;}
@@ -81,12 +435,19 @@ double NelderMead::getReflectionParam()const{return alpha_;}
 double NelderMead::getExpansionParam()const{return beta_;}
 double NelderMead::getContractionParam()const{return gamma_;}
 double NelderMead::getShrinkParam()const{return delta_;}
+std::size_t NelderMead::getCacheCapacity()const{return cacheCapacity_;}
+int NelderMead::getNumberThreads()const{return pool_ ? pool_->getNumberThreads() : 1;}
+int NelderMead::getNumberDirections()const{return numberDirections_;}
 double NelderMead::getFunctionResult(){optimize(); return getError() ? NAN : fResult_;}
 int NelderMead::getNumberIterations(){optimize(); return numberIterations_;}
+double NelderMead::getObjectiveValue(){return getFunctionResult();}
+int NelderMead::getNumberEvaluations(){optimize(); return numberEvaluations_;}
+long long NelderMead::getCacheHits(){optimize(); return cache_.getHits();}
+long long NelderMead::getCacheMisses(){optimize(); return cache_.getMisses();}
 std::vector<double> NelderMead::getResult(){optimize(); return getError() ? std::vector<double>(n_, NAN):result_;}
 
-NelderMead::NelderMead(const std::vector<double>& x0,const std::function<double(std::vector<double>)>& f): 
-x0_(x0), n_(x0.size()), f_(f) 
+NelderMead::NelderMead(const std::vector<double>& x0, Objective objective): 
+x0_(x0), n_(x0.size()), f_(std::move(objective)), numberEvaluations_(0), cacheCapacity_(0), numberDirections_(1)
 {
     setPerturbationParam(0.05); 
     setReflectionParam(1.0); 
@@ -96,169 +457,664 @@ x0_(x0), n_(x0.size()), f_(f)
     setInitSimplexMethod(NelderMead::InitSimplexMethod::BASIC);
 };
 
-NelderMead::Vertex::Vertex(const std::vector<double>& points, double value): points_(points), value_(value){}; 
-NelderMead::Simplex::Simplex(const std::vector<Vertex>& vertices): vertices_(vertices){}; 
-
-void NelderMead::Simplex::sortVertices()
+double NelderMead::getSymAlpha() const {return epsilon_/(2*sqrt(n_));}
+double* NelderMead::getRow(int i) {return vertices_.data() + i * n_;}
+double NelderMead::evaluateVertex(const std::vector<double>& x) 
 {
-    std::sort(vertices_.begin(), vertices_.end(), 
-    [](const NelderMead::Vertex& a, const NelderMead::Vertex& b) {
-        return a.value_ < b.value_;  // Compare values directly
-    });
+    double value;
+    if (cache_.find(x.data(), value)) return value;
+    numberEvaluations_++; 
+    value = timeEvaluation([this, &x]() {return f_.thunk(f_.callable.get(), x);});
+    cache_.insert(x.data(), value);
+    return value;
 }
 
-void NelderMead::Simplex::setVertex(const Vertex& vertex_, int i) {vertices_[i] = vertex_; sortVertices();}
-NelderMead::Vertex NelderMead::Simplex::getBest() const {return vertices_[0];}
-NelderMead::Vertex NelderMead::Simplex::getWorst() const {return vertices_.back();}
-NelderMead::Vertex NelderMead::Simplex::getSecondWorst() const {int n = vertices_.size(); return vertices_[n-2];}
-
-double NelderMead::getSymAlpha() const {return epsilon_/(2*sqrt(n_));}
-NelderMead::Vertex NelderMead::getVertex(std::vector<double> x_input) const {return NelderMead::Vertex(x_input, f_(x_input));}
-
-NelderMead::Simplex NelderMead::getInitialSimplex() const
+void NelderMead::setInitialSimplex()
 {
-    std::vector<NelderMead::Vertex> simplex;
+    // Buffers are sized once per optimization, the iterations then run without allocating.
+    vertices_.resize((n_ + 1) * n_);
+    values_.resize(n_ + 1);
+    order_.resize(n_ + 1);
+    sum_.resize(n_);
+    centroid_.resize(n_);
+    reflection_.resize(n_);
+    trial_.resize(n_);
+    point_.resize(n_);
+    numberEvaluations_ = 0;
+    if (cache_.getCapacity() != cacheCapacity_ || cache_.getDimension() != n_) cache_.reset(n_, cacheCapacity_);
+    cache_.resetCounters();
+    if (isBatched()) {
+        int size = std::max(n_ + 1, 2 * std::min(numberDirections_, n_));
+        batch_.resize(size);
+        for (std::vector<double>& point : batch_) {point.resize(n_);}
+        batchValues_.resize(size);
+        pending_.resize(size);
+        secondSlots_.resize(size);
+    }
+
     double a = getSymAlpha();
-    simplex.push_back(getVertex(x0_));
-    for (int i = 0; i < n_; ++i) {
-        std::vector<double> x = x0_; 
-        switch (initSimplexMethod_)
-        {
-        case NelderMead::InitSimplexMethod::BASIC: x[i] += epsilon_; break;
-        case NelderMead::InitSimplexMethod::SCALED: x[i] += epsilon_ * (1 + fabs(x0_[i])); break;
-        case NelderMead::InitSimplexMethod::SYMMETRIC: 
-            for (int j = 0; j < n_; ++j) {
-                x[j] += (i == j) ? a : (-a / (n_ - 1));
-            };
-            break;
-        default: break;
+    for (int i = 0; i <= n_; ++i) {
+        std::copy(x0_.begin(), x0_.end(), point_.begin());
+        if (i > 0) {
+            int k = i - 1;
+            switch (initSimplexMethod_)
+            {
+            case NelderMead::InitSimplexMethod::BASIC: point_[k] += epsilon_; break;
+            case NelderMead::InitSimplexMethod::SCALED: point_[k] += epsilon_ * (1 + fabs(x0_[k])); break;
+            case NelderMead::InitSimplexMethod::SYMMETRIC: 
+                for (int j = 0; j < n_; ++j) {
+                    point_[j] += (k == j) ? a : (-a / (n_ - 1));
+                };
+                break;
+            default: break;
+            }
         }
-        simplex.push_back(getVertex(x));
-    };
-    return NelderMead::Simplex(simplex);
+        std::copy(point_.begin(), point_.end(), getRow(i));
+        if (isBatched()) std::copy(point_.begin(), point_.end(), batch_[i].begin());
+        else values_[i] = evaluateVertex(point_);
+        order_[i] = i;
+    }
+    if (isBatched()) {
+        evaluateBatch(0, n_ + 1);
+        std::copy(batchValues_.begin(), batchValues_.begin() + n_ + 1, values_.begin());
+    }
+    std::sort(order_.begin(), order_.end(), [this](int a, int b) {return values_[a] < values_[b];});
+    setSum();
 }
 
-NelderMead::Vertex NelderMead::getCentroid(const NelderMead::Simplex& simplex_) const
+void NelderMead::setSum()
 {
-    std::vector<NelderMead::Vertex> simplexVector = simplex_.vertices_;
-    std::vector<double> x_c(n_, 0); 
-    for (int j = 0; j < n_; ++j){
-        for (int i = 0; i < n_; ++i){
-            x_c[i] +=  simplexVector[j].points_[i]/n_;
-        }
+    std::fill(sum_.begin(), sum_.end(), 0.0);
+    for (int i = 0; i <= n_; ++i) {
+        const double* row = getRow(i);
+        for (int j = 0; j < n_; ++j) {sum_[j] += row[j];}
+    }
+}
+
+void NelderMead::setCentroid(int numberMoving)
+{
+    const double* worst = getRow(order_[n_]);
+    if (numberMoving == 1) {
+        for (int j = 0; j < n_; ++j) {centroid_[j] = (sum_[j] - worst[j]) / n_;}
+        return;
+    }
+    std::copy(sum_.begin(), sum_.end(), centroid_.begin());
+    for (int k = n_ + 1 - numberMoving; k <= n_; ++k) {
+        const double* row = getRow(order_[k]);
+        for (int j = 0; j < n_; ++j) {centroid_[j] -= row[j];}
     }
-    return getVertex(x_c);
+    for (int j = 0; j < n_; ++j) {centroid_[j] /= n_ + 1 - numberMoving;}
 }
 
-NelderMead::Vertex NelderMead::getReflection(const NelderMead::Vertex& centroid, const NelderMead::Vertex& worst) const
+bool NelderMead::isBatched() const{return pool_ || numberDirections_ > 1;}
+
+void NelderMead::evaluateBatch(int first, int count)
 {
-    std::vector<double> x(n_); 
-    for (int j = 0; j < n_; ++j){
-        double xw = worst.points_[j];
-        double xc = centroid.points_[j]; 
-        x[j] = xc + alpha_*(xc-xw);
+    if (!pool_) {
+        for (int k = first; k < first + count; ++k) {batchValues_[k] = evaluateVertex(batch_[k]);}
+        return;
+    }
+    // The cache is not thread-safe: it is read before and filled after the concurrent evaluations.
+    int numberPending = 0;
+    for (int k = first; k < first + count; ++k) {
+        if (!cache_.find(batch_[k].data(), batchValues_[k])) pending_[numberPending++] = k;
     }
-    return getVertex(x);
+    timeEvaluation([this, numberPending]() {
+        pool_->parallelFor(numberPending, [this](int i) {
+            int k = pending_[i];
+            batchValues_[k] = f_.thunk(f_.callable.get(), batch_[k]);
+        });
+    });
+    numberEvaluations_ += numberPending;
+    for (int i = 0; i < numberPending; ++i) {cache_.insert(batch_[pending_[i]].data(), batchValues_[pending_[i]]);}
 }
 
-NelderMead::Vertex NelderMead::getExpansion(const NelderMead::Vertex& centroid, const NelderMead::Vertex& reflection) const
+OptimizerTrace::Step NelderMead::stepDirections(int p)
 {
-    std::vector<double> x(n_); 
-    for (int j = 0; j < n_; ++j){
-        double xr = reflection.points_[j];
-        double xc = centroid.points_[j]; 
-        x[j] = xc + beta_*(xr-xc);
+    // Direction j moves the vertex ranked n - j, against the centroid of the n + 1 - p best vertices. Trial 
+    // points are evaluated in two rounds: all the reflections, then the expansions and contractions.
+    setCentroid(p);
+    double bestValue = values_[order_[0]];
+    double keptWorstValue = values_[order_[n_ - p]];
+    for (int j = 0; j < p; ++j) {setTrial(batch_[j], getRow(order_[n_ - j]), -alpha_);}
+    evaluateBatch(0, p);
+
+    int numberSecond = 0;
+    for (int j = 0; j < p; ++j) {
+        double reflectionValue = batchValues_[j];
+        secondSlots_[j] = -1;
+        if (reflectionValue < keptWorstValue && reflectionValue >= bestValue) continue;
+        secondSlots_[j] = p + numberSecond++;
+        if (reflectionValue < bestValue) {
+            setTrial(batch_[secondSlots_[j]], batch_[j].data(), beta_);
+        } else {
+            bool outside = reflectionValue < values_[order_[n_ - j]];
+            setTrial(batch_[secondSlots_[j]], outside ? batch_[j].data() : getRow(order_[n_ - j]), gamma_);
+        }
+    }
+    evaluateBatch(p, numberSecond);
+
+    // Same acceptance rules as the classic step, each direction on its own vertex.
+    OptimizerTrace::Step step = OptimizerTrace::Step::CONTRACT;
+    bool improved = false;
+    for (int j = 0; j < p; ++j) {
+        int row = order_[n_ - j];
+        double reflectionValue = batchValues_[j];
+        int slot = j;
+        if (reflectionValue < bestValue) {
+            if (batchValues_[secondSlots_[j]] < reflectionValue) {slot = secondSlots_[j]; step = OptimizerTrace::Step::EXPAND;}
+            else if (step != OptimizerTrace::Step::EXPAND) step = OptimizerTrace::Step::REFLECT;
+        } else if (reflectionValue < keptWorstValue) {
+            if (step != OptimizerTrace::Step::EXPAND) step = OptimizerTrace::Step::REFLECT;
+        } else {
+            double threshold = std::min(reflectionValue, values_[row]);
+            if (!(batchValues_[secondSlots_[j]] < threshold)) continue;
+            slot = secondSlots_[j];
+        }
+        std::copy(batch_[slot].begin(), batch_[slot].end(), getRow(row));
+        values_[row] = batchValues_[slot];
+        improved = true;
+    }
+    if (!improved) {
+        shrink();
+        return OptimizerTrace::Step::SHRINK;
     }
-    return getVertex(x);
+    std::sort(order_.begin(), order_.end(), [this](int a, int b) {return values_[a] < values_[b];});
+    setSum();
+    return step;
 }
 
-NelderMead::Vertex NelderMead::getContraction(const NelderMead::Vertex& centroid, const NelderMead::Vertex& worst) const
+void NelderMead::setTrial(std::vector<double>& x, const double* from, double coefficient)
 {
-    std::vector<double> x(n_); 
-    for (int j = 0; j < n_; ++j){
-        double xw = worst.points_[j];
-        double xc = centroid.points_[j]; 
-        x[j] = xc + gamma_*(xw-xc);
+    for (int j = 0; j < n_; ++j) {x[j] = centroid_[j] + coefficient * (from[j] - centroid_[j]);}
+}
+
+void NelderMead::replaceWorst(const std::vector<double>& x, double value)
+{
+    int worst = order_[n_];
+    double* row = getRow(worst);
+    for (int j = 0; j < n_; ++j) {
+        sum_[j] += x[j] - row[j];
+        row[j] = x[j];
+    }
+    values_[worst] = value;
+    int k = n_;
+    while (k > 0 && values_[order_[k - 1]] > value) {
+        order_[k] = order_[k - 1];
+        --k;
     }
-    return getVertex(x);
+    order_[k] = worst;
 }
 
-NelderMead::Simplex NelderMead::getShrink(const NelderMead::Simplex& simplex_) const
+void NelderMead::shrink()
 {
-    std::vector<NelderMead::Vertex> simplexOut;
-    std::vector<NelderMead::Vertex> simplexIn = simplex_.vertices_;
-    simplexOut.push_back(simplexIn[0]); 
-    for (int j = 1; j < n_; ++j){
-        std::vector<double> x(n_); 
-        for (int i = 0; i < n_; ++i){
-            x[i] = simplexIn[0].points_[i] + delta_*(simplexIn[j].points_[i] - simplexIn[0].points_[i]);
+    const double* best = getRow(order_[0]);
+    for (int k = 1; k <= n_; ++k) {
+        int i = order_[k];
+        double* row = getRow(i);
+        for (int j = 0; j < n_; ++j) {row[j] = best[j] + delta_ * (row[j] - best[j]);}
+        if (isBatched()) {
+            std::copy(row, row + n_, batch_[k - 1].begin());
+            continue;
         }
-        simplexOut.push_back(getVertex(x)); 
-    } 
-    return NelderMead::Simplex(simplexOut);
+        std::copy(row, row + n_, point_.begin());
+        values_[i] = evaluateVertex(point_);
+    }
+    if (isBatched()) {
+        evaluateBatch(0, n_);
+        for (int k = 1; k <= n_; ++k) {values_[order_[k]] = batchValues_[k - 1];}
+    }
+    std::sort(order_.begin(), order_.end(), [this](int a, int b) {return values_[a] < values_[b];});
+    setSum();
 }
 
-bool NelderMead::checkConvergence(const NelderMead::Simplex& simplex_) const
+double NelderMead::getDiameter() const
 {
     double maxDistance = 0.0;
-    double maxValue = 0.0;
-    for (int i = 1; i < n_; i++) {
+    const double* best = vertices_.data() + order_[0] * n_;
+    for (int k = 1; k <= n_; k++) {
+        const double* row = vertices_.data() + order_[k] * n_;
         double distance = 0.0;
         for (int j = 0; j < n_; j++) {
-            distance += std::pow(simplex_.vertices_[i].points_[j] - simplex_.vertices_[0].points_[j], 2);
+            distance += (row[j] - best[j]) * (row[j] - best[j]);
         }
         maxDistance = std::max(maxDistance, std::sqrt(distance));
-        maxValue = std::max(maxValue, std::abs(simplex_.vertices_[i].value_ - simplex_.vertices_[0].value_));
     }
-    return (maxDistance < getToleranceThreshold() || maxValue < getToleranceThreshold());
+    return maxDistance;
+}
+
+bool NelderMead::checkConvergence() const
+{
+    double maxValue = 0.0;
+    for (int k = 1; k <= n_; k++) {
+        maxValue = std::max(maxValue, std::abs(values_[order_[k]] - values_[order_[0]]));
+    }
+    // The value spread is the cheaper test, and usually the first one met.
+    return maxValue < getToleranceThreshold() || getDiameter() < getToleranceThreshold();
+}
+
+OptimizerTrace::Step NelderMead::stepSimplex()
+{
+    setCentroid(1); 
+    const double* worst = getRow(order_[n_]);
+    double worstValue = values_[order_[n_]];
+    double bestValue = values_[order_[0]];
+    double secondWorstValue = values_[order_[n_ - 1]];
+    setTrial(reflection_, worst, -alpha_);
+    double reflectionValue = evaluateVertex(reflection_);
+    OptimizerTrace::Step step = OptimizerTrace::Step::REFLECT;
+
+    if (reflectionValue<bestValue){
+        setTrial(trial_, reflection_.data(), beta_);
+        double expansionValue = evaluateVertex(trial_);
+        if (expansionValue<reflectionValue){
+            replaceWorst(trial_, expansionValue);
+            step = OptimizerTrace::Step::EXPAND;
+        }else{
+            replaceWorst(reflection_, reflectionValue);
+        }
+    }
+    else if (reflectionValue<secondWorstValue){
+        replaceWorst(reflection_, reflectionValue);
+    }
+    else {
+        // Outside contraction towards the reflection, inside contraction towards the worst vertex.
+        bool outside = reflectionValue<worstValue;
+        setTrial(trial_, outside ? reflection_.data() : worst, gamma_);
+        double contractionValue = evaluateVertex(trial_);
+        if (contractionValue < (outside ? reflectionValue : worstValue)){
+            replaceWorst(trial_, contractionValue);
+            step = OptimizerTrace::Step::CONTRACT;
+        }else{
+            shrink();
+            step = OptimizerTrace::Step::SHRINK;
+        }
+    }
+    return step;
 }
 
 void NelderMead::_optimize()
 {
-    NelderMead::Simplex simplex = getInitialSimplex(); 
+    setInitialSimplex(); 
+    if (isTraced()) traceIteration(0, OptimizerTrace::Step::INITIAL, values_[order_[0]], getDiameter(), numberEvaluations_);
     numberIterations_ = 1;
     for (int iter = 1; iter <= getMaximumIterations(); iter++) {
-        if (checkConvergence(simplex)){break;}
-        NelderMead::Vertex centroid = getCentroid(simplex); 
-        NelderMead::Vertex worst = simplex.getWorst(); 
-        NelderMead::Vertex reflection = getReflection(centroid,worst);
-        NelderMead::Vertex best = simplex.getBest(); 
-        NelderMead::Vertex second_worst = simplex.getSecondWorst(); 
-
-        if (reflection.value_<best.value_){
-            NelderMead::Vertex expansion = getExpansion(centroid, reflection); 
-            if (expansion.value_<reflection.value_){
-                simplex.setVertex(expansion, simplex.vertices_.size()-1);
-            }else{
-                simplex.setVertex(reflection, simplex.vertices_.size()-1);
-            }
-        }
-        else if (reflection.value_>=best.value_ and reflection.value_<second_worst.value_){
-            simplex.setVertex(reflection, simplex.vertices_.size()-1);
-        }
-        else {
-            
-            if (reflection.value_<worst.value_){
-                NelderMead::Vertex contraction = getContraction(centroid, reflection);
-                if (contraction.value_<reflection.value_){
-                    simplex.setVertex(contraction, simplex.vertices_.size()-1);
-                }else{
-                    simplex = getShrink(simplex);
-                }
-            }else{
-                NelderMead::Vertex contraction = getContraction(centroid, worst);
-                if (contraction.value_<worst.value_){
-                    simplex.setVertex(contraction, simplex.vertices_.size()-1);
-                }else{
-                    simplex = getShrink(simplex);
-                }
-            }
-        }
+        if (checkConvergence() || isCancelled()){break;}
+        // Refresh the running sum now and then, so that rounding does not accumulate in the centroid.
+        if (iter % (n_ + 1) == 0) setSum();
+        int p = std::min(numberDirections_, n_);
+        OptimizerTrace::Step step = p > 1 ? stepDirections(p) : stepSimplex();
+        if (isTraced()) traceIteration(iter, step, values_[order_[0]], getDiameter(), numberEvaluations_);
         if (numberIterations_==getMaximumIterations()){break;}
         
         numberIterations_++;
 
     };
-    result_ = simplex.vertices_[0].points_; 
-    fResult_ = simplex.vertices_[0].value_; 
-}
\ No newline at end of file
+    const double* best = getRow(order_[0]);
+    result_.assign(best, best + n_); 
+    fResult_ = values_[order_[0]]; 
+}
+
+LBFGS::LBFGS(const Eigen::VectorXd& x0, const Function& f): LBFGS(x0, f, nullptr){};
+
+LBFGS::LBFGS(const Eigen::VectorXd& x0, const Function& f, const Gradient& gradient): 
+x0_(x0), f_(f), gradient_(gradient), historySize_(10), differences_(FiniteDifference::Method::CENTRAL), head_(0), count_(0), 
+fResult_(NAN), numberIterations_(0), numberEvaluations_(0){};
+
+void LBFGS::setStartValues(const Eigen::VectorXd& x0){x0_ = x0; setOptimized(false);}
+void LBFGS::setHistorySize(int m){historySize_ = std::max(1, m); setOptimized(false);}
+void LBFGS::setFiniteDifference(const FiniteDifference& differences){differences_ = differences; setOptimized(false);}
+
+Eigen::VectorXd LBFGS::getStartValues() const{return x0_;}
+int LBFGS::getHistorySize() const{return historySize_;}
+const FiniteDifference& LBFGS::getFiniteDifference() const{return differences_;}
+Eigen::VectorXd LBFGS::getResult(){optimize(); return getError() ? Eigen::VectorXd::Constant(x0_.size(), NAN) : x_;}
+Eigen::VectorXd LBFGS::getGradientResult(){optimize(); return getError() ? Eigen::VectorXd::Constant(x0_.size(), NAN) : g_;}
+double LBFGS::getFunctionResult(){optimize(); return getError() ? NAN : fResult_;}
+int LBFGS::getNumberIterations(){optimize(); return numberIterations_;}
+double LBFGS::getObjectiveValue(){return getFunctionResult();}
+int LBFGS::getNumberEvaluations(){optimize(); return numberEvaluations_;}
+
+double LBFGS::evaluateFunction(const Eigen::VectorXd& x) {numberEvaluations_++; return timeEvaluation([this, &x]() {return f_(x);});}
+
+void LBFGS::evaluateGradient(const Eigen::VectorXd& x, double fx, Eigen::VectorXd& gradient)
+{
+    if (gradient_) {timeEvaluation([&]() {gradient_(x, gradient);}); return;}
+    timeEvaluation([&]() {differences_.gradient(f_, x, fx, gradient);});
+    numberEvaluations_ += differences_.getNumberEvaluations();
+}
+
+void LBFGS::setDirection()
+{
+    // Two-loop recursion: direction_ = -H g, H the inverse Hessian approximation from the stored pairs.
+    direction_ = g_;
+    for (int k = 0; k < count_; ++k) {
+        int j = (head_ - k + historySize_) % historySize_;
+        alpha_[j] = rho_[j] * s_.col(j).dot(direction_);
+        direction_ -= alpha_[j] * y_.col(j);
+    }
+    if (count_ > 0) direction_ *= 1.0 / (rho_[head_] * y_.col(head_).squaredNorm());
+    for (int k = count_ - 1; k >= 0; --k) {
+        int j = (head_ - k + historySize_) % historySize_;
+        double beta = rho_[j] * y_.col(j).dot(direction_);
+        direction_ += (alpha_[j] - beta) * s_.col(j);
+    }
+    direction_ = -direction_;
+}
+
+void LBFGS::_optimize()
+{
+    int n = x0_.size();
+    s_.resize(n, historySize_);
+    y_.resize(n, historySize_);
+    rho_.resize(historySize_);
+    alpha_.resize(historySize_);
+    g_.resize(n);
+    gNew_.resize(n);
+    x_ = x0_;
+    head_ = historySize_ - 1;
+    count_ = 0;
+    numberEvaluations_ = 0;
+    numberIterations_ = 0;
+
+    double fX = evaluateFunction(x_);
+    evaluateGradient(x_, fX, g_);
+    if (isTraced()) traceIteration(0, OptimizerTrace::Step::INITIAL, fX, 0.0, numberEvaluations_);
+    for (int i = 1; i <= getMaximumIterations(); ++i) {
+        if (g_.lpNorm<Eigen::Infinity>() < getToleranceThreshold() || isCancelled()) break;
+        numberIterations_ = i;
+
+        setDirection();
+        double slope = direction_.dot(g_);
+        if (!(slope < 0.0)) {
+            // Not a descent direction (lost curvature information): restart from steepest descent.
+            count_ = 0;
+            direction_ = -g_;
+            slope = -g_.squaredNorm();
+        }
+        // Without curvature information the first step is scaled to unit length.
+        double t = count_ > 0 ? 1.0 : std::min(1.0, 1.0 / direction_.norm());
+        double fNew = NAN;
+        bool accepted = false;
+        for (int k = 0; k < 50; ++k) {
+            xNew_ = x_ + t * direction_;
+            fNew = evaluateFunction(xNew_);
+            if (fNew <= fX + 1e-4 * t * slope) {accepted = true; break;}
+            t *= 0.5;
+        }
+        if (!accepted) {
+            if (isTraced()) traceIteration(i, OptimizerTrace::Step::REJECTED, fX, t * direction_.norm(), numberEvaluations_);
+            throw MathErrorRegistry::Optim::LineSearchError();
+        }
+        evaluateGradient(xNew_, fNew, gNew_);
+
+        int next = (head_ + 1) % historySize_;
+        s_.col(next) = xNew_ - x_;
+        y_.col(next) = gNew_ - g_;
+        double curvature = s_.col(next).dot(y_.col(next));
+        // Pairs without positive curvature would break the positive definiteness of H: they are skipped (the 
+        // oldest pair, whose slot was overwritten, is dropped with them).
+        if (curvature > 1e-12 * s_.col(next).norm() * y_.col(next).norm()) {
+            rho_[next] = 1.0 / curvature;
+            head_ = next;
+            count_ = std::min(count_ + 1, historySize_);
+        } else if (count_ == historySize_) {
+            count_--;
+        }
+        bool converged = std::abs(fX - fNew) < getToleranceThreshold() * (1.0 + std::abs(fX));
+        if (isTraced()) traceIteration(i, OptimizerTrace::Step::LINE_SEARCH, fNew, t * direction_.norm(), numberEvaluations_);
+        x_.swap(xNew_);
+        g_.swap(gNew_);
+        fX = fNew;
+        if (converged) break;
+    }
+    fResult_ = fX;
+}
+
+LevenbergMarquardt::LevenbergMarquardt(const Eigen::VectorXd& x0, const Model& model, const Eigen::VectorXd& trueValues): 
+LevenbergMarquardt(x0, model, trueValues, nullptr){};
+
+LevenbergMarquardt::LevenbergMarquardt(const Eigen::VectorXd& x0, const Model& model, const Eigen::VectorXd& trueValues, const Jacobian& jacobian): 
+x0_(x0), model_(model), trueValues_(trueValues), jacobian_(jacobian), differences_(FiniteDifference::Method::FORWARD), fResult_(NAN), 
+numberIterations_(0), numberEvaluations_(0){};
+
+void LevenbergMarquardt::setStartValues(const Eigen::VectorXd& x0){x0_ = x0; setOptimized(false);}
+void LevenbergMarquardt::setFiniteDifference(const FiniteDifference& differences){differences_ = differences; setOptimized(false);}
+
+Eigen::VectorXd LevenbergMarquardt::getStartValues() const{return x0_;}
+const FiniteDifference& LevenbergMarquardt::getFiniteDifference() const{return differences_;}
+Eigen::VectorXd LevenbergMarquardt::getResult(){optimize(); return getError() ? Eigen::VectorXd::Constant(x0_.size(), NAN) : x_;}
+EstimatorLoss LevenbergMarquardt::getResidualsObject()
+{
+    optimize(); 
+    if (getError()) std::rethrow_exception(getError());
+    return EstimatorLoss(estimates_, trueValues_);
+}
+double LevenbergMarquardt::getFunctionResult(){optimize(); return getError() ? NAN : fResult_;}
+int LevenbergMarquardt::getNumberIterations(){optimize(); return numberIterations_;}
+double LevenbergMarquardt::getObjectiveValue(){return getFunctionResult();}
+int LevenbergMarquardt::getNumberEvaluations(){optimize(); return numberEvaluations_;}
+
+void LevenbergMarquardt::evaluateResiduals(const Eigen::VectorXd& x, Eigen::VectorXd& estimates, Eigen::VectorXd& residuals)
+{
+    numberEvaluations_++;
+    timeEvaluation([&]() {model_(x, estimates);});
+    residuals = estimates - trueValues_;
+}
+
+void LevenbergMarquardt::evaluateJacobian()
+{
+    if (jacobian_) {timeEvaluation([this]() {jacobian_(x_, J_);}); return;}
+    // Forward differences reuse the estimates at x_.
+    timeEvaluation([this]() {differences_.jacobian(model_, x_, estimates_, J_);});
+    numberEvaluations_ += differences_.getNumberEvaluations();
+}
+
+void LevenbergMarquardt::_optimize()
+{
+    int n = x0_.size(), m = trueValues_.size();
+    if (m == 0) throw MathErrorRegistry::Loss::EmptyVectorError();
+    estimates_.resize(m);
+    estimatesNew_.resize(m);
+    residuals_.resize(m);
+    residualsNew_.resize(m);
+    J_.resize(m, n);
+    JtJ_.resize(n, n);
+    A_.resize(n, n);
+    gradient_.resize(n);
+    delta_.resize(n);
+    x_ = x0_;
+    numberEvaluations_ = 0;
+    numberIterations_ = 0;
+
+    evaluateResiduals(x_, estimates_, residuals_);
+    double cost = 0.5 * residuals_.squaredNorm();
+    evaluateJacobian();
+    if (isTraced()) traceIteration(0, OptimizerTrace::Step::INITIAL, cost, 0.0, numberEvaluations_);
+    double lambda = -1.0, nu = 2.0;
+    for (int i = 1; i <= getMaximumIterations(); ++i) {
+        JtJ_.noalias() = J_.transpose() * J_;
+        gradient_.noalias() = J_.transpose() * residuals_;
+        if (gradient_.lpNorm<Eigen::Infinity>() < getToleranceThreshold() || isCancelled()) break;
+        numberIterations_ = i;
+        // Damping of Madsen, Nielsen and Tingleff: started from the scale of J'J, then updated from the gain ratio.
+        if (lambda < 0.0) lambda = 1e-3 * JtJ_.diagonal().maxCoeff();
+
+        A_ = JtJ_;
+        A_.diagonal().array() += lambda;
+        llt_.compute(A_);
+        delta_ = -gradient_;
+        llt_.solveInPlace(delta_);
+        if (delta_.norm() < getToleranceThreshold() * (x_.norm() + getToleranceThreshold())) break;
+
+        xNew_ = x_ + delta_;
+        evaluateResiduals(xNew_, estimatesNew_, residualsNew_);
+        double costNew = 0.5 * residualsNew_.squaredNorm();
+        double predicted = 0.5 * delta_.dot(lambda * delta_ - gradient_);
+        double gain = (cost - costNew) / predicted;
+        if (gain > 0.0 && std::isfinite(costNew)) {
+            bool converged = cost - costNew < getToleranceThreshold() * (1.0 + cost);
+            x_.swap(xNew_);
+            estimates_.swap(estimatesNew_);
+            residuals_.swap(residualsNew_);
+            cost = costNew;
+            if (isTraced()) traceIteration(i, OptimizerTrace::Step::DAMPED, cost, delta_.norm(), numberEvaluations_);
+            if (converged) break;
+            evaluateJacobian();
+            lambda *= std::max(1.0 / 3.0, 1.0 - std::pow(2.0 * gain - 1.0, 3));
+            nu = 2.0;
+        } else {
+            if (isTraced()) traceIteration(i, OptimizerTrace::Step::REJECTED, cost, delta_.norm(), numberEvaluations_);
+            lambda *= nu;
+            nu *= 2.0;
+        }
+    }
+    fResult_ = cost;
+}
+
+BatchNewtonRaphson::BatchNewtonRaphson(const Eigen::Ref<const Eigen::ArrayXd>& x0, const Function& f, const Function& fDeriv): 
+x0_(x0), f_(f), fDeriv_(fDeriv), numberIterations_(0){};
+
+const Eigen::ArrayXd& BatchNewtonRaphson::getResults(){optimize(); return result_;}
+const Eigen::ArrayXd& BatchNewtonRaphson::getFunctionResults(){optimize(); return fResult_;}
+const std::vector<BatchNewtonRaphson::Status>& BatchNewtonRaphson::getStatuses(){optimize(); return statuses_;}
+const Eigen::ArrayXi& BatchNewtonRaphson::getLaneIterations(){optimize(); return laneIterations_;}
+int BatchNewtonRaphson::getNumberIterations(){optimize(); return numberIterations_;}
+int BatchNewtonRaphson::getNumberLanes() const{return x0_.size();}
+const Eigen::ArrayXd& BatchNewtonRaphson::getStartValues() const{return x0_;}
+void BatchNewtonRaphson::setStartValues(const Eigen::Ref<const Eigen::ArrayXd>& x0){x0_ = x0; setOptimized(false);}
+
+double BatchNewtonRaphson::getObjectiveValue()
+{
+    optimize();
+    if (getError()) return NAN;
+    double value = 0.0;
+    for (int k = 0; k < getNumberLanes(); ++k) {
+        if (statuses_[k] == Status::CONVERGED || statuses_[k] == Status::MAXIMUM_ITERATIONS) value = std::max(value, std::abs(fResult_[k]));
+    }
+    return value;
+}
+
+void BatchNewtonRaphson::_optimize()
+{
+    // Same per-lane steps and stopping rules as NewtonRaphson.
+    int n = getNumberLanes();
+    Eigen::ArrayXd& x = result_;
+    x = x0_;
+    fResult_.resize(n);
+    fDerivResult_.resize(n);
+    laneIterations_.setZero(n);
+    statuses_.assign(n, Status::MAXIMUM_ITERATIONS);
+    std::vector<char> active(n, 1);
+    int numberActive = n;
+    numberIterations_ = 0;
+    for (int i = 1; i <= getMaximumIterations() && numberActive > 0 && !isCancelled(); ++i) {
+        numberIterations_++;
+        f_(x, fResult_);
+        fDeriv_(x, fDerivResult_);
+        for (int k = 0; k < n; ++k) {
+            if (!active[k]) continue;
+            laneIterations_[k]++;
+            double fX = fResult_[k], dfX = fDerivResult_[k];
+            Status status = Status::MAXIMUM_ITERATIONS;
+            if (!std::isfinite(fX) || !std::isfinite(dfX)) status = Status::NOT_FINITE;
+            else if (std::abs(fX) < getToleranceThreshold()) status = Status::CONVERGED;
+            else if (std::abs(dfX) < 1e-12) status = Status::DERIVATIVE_ZERO;
+            else {
+                double xNew = x[k] - fX / dfX;
+                bool converged = std::abs(xNew - x[k]) < getToleranceThreshold();
+                // As for NewtonRaphson, the last iteration keeps the point its function value belongs to.
+                if (converged || i < getMaximumIterations()) x[k] = xNew;
+                if (!converged) continue;
+                status = Status::CONVERGED;
+            }
+            statuses_[k] = status;
+            active[k] = 0;
+            numberActive--;
+        }
+    }
+    for (int k = 0; k < n; ++k) {
+        if (statuses_[k] == Status::DERIVATIVE_ZERO || statuses_[k] == Status::NOT_FINITE) x[k] = NAN;
+    }
+}
+
+BatchOptimizer::BatchOptimizer(const std::vector<std::shared_ptr<Optimizer>>& problems, int numberThreads): 
+problems_(problems), numberThreads_(numberThreads), targetValue_(-INFINITY), optimized_(false), timeTaken_(0.0), cancelled_(false), 
+pool_(std::make_unique<ThreadPool>(numberThreads)){}
+
+BatchOptimizer::BatchOptimizer(const NelderMead& problem, const std::vector<std::vector<double>>& startValues, int numberThreads): 
+BatchOptimizer(std::vector<std::shared_ptr<Optimizer>>(), numberThreads)
+{
+    for (const std::vector<double>& x0 : startValues) {
+        std::shared_ptr<NelderMead> copy = std::make_shared<NelderMead>(problem);
+        copy->setStartValues(x0);
+        copy->setTrace(nullptr);
+        problems_.push_back(copy);
+    }
+}
+
+BatchOptimizer::BatchOptimizer(const NewtonRaphson& problem, const std::vector<double>& startValues, int numberThreads): 
+BatchOptimizer(std::vector<std::shared_ptr<Optimizer>>(), numberThreads)
+{
+    for (double x0 : startValues) {
+        std::shared_ptr<NewtonRaphson> copy = std::make_shared<NewtonRaphson>(problem);
+        copy->setStartValue(x0);
+        copy->setTrace(nullptr);
+        problems_.push_back(copy);
+    }
+}
+
+void BatchOptimizer::setTargetValue(double target){targetValue_ = target; optimized_ = false;}
+void BatchOptimizer::setNumberThreads(int numberThreads){numberThreads_ = numberThreads; pool_ = std::make_unique<ThreadPool>(numberThreads);}
+bool BatchOptimizer::isOptimized() const{return optimized_;}
+double BatchOptimizer::getTargetValue() const{return targetValue_;}
+int BatchOptimizer::getNumberThreads() const{return numberThreads_;}
+int BatchOptimizer::getNumberProblems() const{return problems_.size();}
+double BatchOptimizer::getTimeTaken() const{return timeTaken_;}
+std::shared_ptr<Optimizer> BatchOptimizer::getProblem(int i) const{return problems_.at(i);}
+const std::vector<BatchOptimizer::Report>& BatchOptimizer::getReports(){optimize(); return reports_;}
+
+int BatchOptimizer::getBestIndex()
+{
+    optimize();
+    int best = -1;
+    for (int i = 0; i < getNumberProblems(); ++i) {
+        if (reports_[i].status == Status::COMPLETED && (best < 0 || reports_[i].objectiveValue < reports_[best].objectiveValue)) best = i;
+    }
+    return best;
+}
+
+void BatchOptimizer::run(int i)
+{
+    Report& report = reports_[i];
+    Optimizer& problem = *problems_[i];
+    if (cancelled_) return;
+    problem.setCancellationFlag(&cancelled_);
+    problem.optimize();
+    // Read while the flag is set: an interrupted problem would otherwise run again. It does on the next
+    // optimize(), as the flag is cleared.
+    report.numberIterations = problem.getNumberIterations();
+    report.objectiveValue = problem.getObjectiveValue();
+    report.timeTaken = problem.getTimeTaken();
+    report.error = problem.getError();
+    // A problem that ended after the cancellation may have been interrupted before converging.
+    bool interrupted = !problem.isOptimized();
+    problem.setCancellationFlag(nullptr);
+    if (report.error) {report.status = Status::FAILED; return;}
+    if (report.objectiveValue <= targetValue_) {cancelled_ = true; report.status = Status::COMPLETED; return;}
+    report.status = interrupted ? Status::CANCELLED : Status::COMPLETED;
+}
+
+void BatchOptimizer::optimize()
+{
+    if (optimized_) return;
+    auto start = std::chrono::high_resolution_clock::now();
+    int n = getNumberProblems();
+    reports_.assign(n, Report{Status::CANCELLED, 0, NAN, 0.0, nullptr});
+    cancelled_ = false;
+    pool_->parallelFor(n, [this](int i) {run(i);});
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> elapsed = end - start;
+    timeTaken_ = elapsed.count();
+    optimized_ = true;
+}
@@ -1,62 +1,489 @@
 #include "../include/core-math/quadratures.hpp"
 
-GaussianQuadrature::GaussianQuadrature(int points): points_(std::max(2, points)), computed_(false), roots_({}), weights_({}){}; 
+namespace
+{
+    // Newton step p_n(x) / p_n'(x) and log(sum_{k<n} p_k(x)^2) for the polynomials of the Jacobi matrix (a, b),
+    // normalized by p_0 = 1. They grow quickly outside the bulk of the nodes, so they are rescaled on the way.
+    // inverseB[k] = 1 / b[k], and 1 for the missing b_{n-1}: p_n is only needed up to a constant factor.
+    void evaluateRecurrence(const std::vector<double>& a, const std::vector<double>& b, const std::vector<double>& inverseB, double x, double& step, double& logSum)
+    {
+        const double scale = 1e-100;
+        int n = a.size();
+        double previous = 0.0, current = 1.0, dPrevious = 0.0, dCurrent = 0.0, sum = 0.0, logScale = 0.0;
+        for (int k = 0; k < n; k++)
+        {
+            sum += current * current;
+            double bkm1 = k > 0 ? b[k - 1] : 0.0;
+            double next = ((x - a[k]) * current - bkm1 * previous) * inverseB[k];
+            double dNext = (current + (x - a[k]) * dCurrent - bkm1 * dPrevious) * inverseB[k];
+            previous = current;
+            current = next;
+            dPrevious = dCurrent;
+            dCurrent = dNext;
+            if (std::max(std::abs(current), std::abs(dCurrent)) > 1.0 / scale)
+            {
+                previous *= scale;
+                current *= scale;
+                dPrevious *= scale;
+                dCurrent *= scale;
+                sum *= scale * scale;
+                logScale -= 2.0 * std::log(scale);
+            }
+        }
+        step = current / dCurrent;
+        logSum = std::log(sum) + logScale;
+    }
+
+    using NodeKey = std::tuple<std::type_index, int, double>;
+
+    std::mutex& getCacheMutex()
+    {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    std::map<NodeKey, std::shared_ptr<const QuadratureNodes>>& getCacheEntries()
+    {
+        static std::map<NodeKey, std::shared_ptr<const QuadratureNodes>> entries;
+        return entries;
+    }
+}
+
+std::shared_ptr<const QuadratureNodes> QuadratureNodeCache::get(const std::type_index& rule, int points, double parameter, const std::function<QuadratureNodes()>& build)
+{
+    NodeKey key(rule, points, parameter);
+    {
+        std::lock_guard<std::mutex> lock(getCacheMutex());
+        auto it = getCacheEntries().find(key);
+        if (it != getCacheEntries().end()) return it->second;
+    }
+    // Built outside the lock, so that large rules do not serialize the other lookups; if two threads build
+    // the same entry the first insertion wins and both return it.
+    auto nodes = std::make_shared<const QuadratureNodes>(build());
+    std::lock_guard<std::mutex> lock(getCacheMutex());
+    return getCacheEntries().emplace(key, nodes).first->second;
+}
+
+std::size_t QuadratureNodeCache::getSize()
+{
+    std::lock_guard<std::mutex> lock(getCacheMutex());
+    return getCacheEntries().size();
+}
+
+void QuadratureNodeCache::clear()
+{
+    std::lock_guard<std::mutex> lock(getCacheMutex());
+    getCacheEntries().clear();
+}
+
+QuadratureNodes GaussianQuadrature::computeGolubWelsch(const std::vector<double>& diagonal, const std::vector<double>& offDiagonal, double mass)
+{
+    int n = diagonal.size();
+    const double epsilon = std::numeric_limits<double>::epsilon();
+    std::vector<double> d(diagonal), e(offDiagonal);
+    e.resize(n, 0.0);
+
+    // Implicit QL with Wilkinson shifts, eigenvalues only (EISPACK imtql1).
+    for (int l = 0; l < n; l++)
+    {
+        for (int iteration = 0; iteration < 30; iteration++)
+        {
+            int m = l;
+            for (; m < n - 1; m++)
+            {
+                if (std::abs(e[m]) <= epsilon * (std::abs(d[m]) + std::abs(d[m + 1]))) break;
+            }
+            if (m == l) break;
+            double g = (d[l + 1] - d[l]) / (2.0 * e[l]);
+            // Plain square roots rather than std::hypot: the entries of Jacobi matrices are far from overflow.
+            double r = std::sqrt(g * g + 1.0);
+            g = d[m] - d[l] + e[l] / (g + std::copysign(r, g));
+            double s = 1.0, c = 1.0, p = 0.0;
+            int i = m - 1;
+            for (; i >= l; i--)
+            {
+                double f = s * e[i], b = c * e[i];
+                e[i + 1] = r = std::sqrt(f * f + g * g);
+                if (r == 0.0)
+                {
+                    // Deflation: the matrix split at i, start again on the lower block.
+                    d[i + 1] -= p;
+                    e[m] = 0.0;
+                    break;
+                }
+                s = f / r;
+                c = g / r;
+                g = d[i + 1] - p;
+                r = (d[i] - g) * s + 2.0 * c * b;
+                p = s * r;
+                d[i + 1] = g + p;
+                g = c * r - b;
+            }
+            if (r == 0.0 && i >= l) continue;
+            d[l] -= p;
+            e[l] = g;
+            e[m] = 0.0;
+        }
+    }
+    std::sort(d.begin(), d.end());
+
+    QuadratureNodes nodes{d, std::vector<double>(n), {}};
+    std::vector<double> inverseB(n, 1.0);
+    for (int k = 0; k + 1 < n; k++) inverseB[k] = 1.0 / offDiagonal[k];
+    for (int i = 0; i < n; i++)
+    {
+        double& x = nodes.roots[i];
+        double step = 0.0, logSum = 0.0;
+        // The eigenvalues are accurate relative to the norm of the matrix: Newton steps recover the relative
+        // accuracy of the small nodes. The second step is already at the rounding level of the recurrence, and the
+        // weight comes from that last evaluation. Steps that are not small corrections are rejected.
+        for (int iteration = 0; iteration < 2; iteration++)
+        {
+            evaluateRecurrence(diagonal, offDiagonal, inverseB, x, step, logSum);
+            if (!std::isfinite(step) || std::abs(step) > 1e-6 * (1.0 + std::abs(x))) break;
+            x -= step;
+        }
+        nodes.weights[i] = mass * std::exp(-logSum);
+    }
+    return nodes;
+}
+
+GaussianQuadrature::GaussianQuadrature(int points): points_(std::max(2, points)), shift_(0.0), scale_(1.0), nodes_(nullptr){}; 
 
 int GaussianQuadrature::getPoints() const{return points_;}
-bool GaussianQuadrature::isComputed() const{return computed_;}
-std::vector<double> GaussianQuadrature::getRoots(){compute();return roots_;}
-std::vector<double> GaussianQuadrature::getWeights(){compute();return weights_;}
+bool GaussianQuadrature::isComputed() const{return nodes_ != nullptr;}
+double GaussianQuadrature::getParameter() const{return 0.0;}
+double GaussianQuadrature::getShift() const{return shift_;}
+double GaussianQuadrature::getScale() const{return scale_;}
+void GaussianQuadrature::setAffineMap(double shift, double scale){shift_ = shift; scale_ = scale;}
+const QuadratureNodes& GaussianQuadrature::getNodes(){compute(); return *nodes_;}
+
+std::vector<double> GaussianQuadrature::getRoots()
+{
+    std::vector<double> roots = getNodes().roots;
+    for (double& root : roots) root = shift_ + scale_ * root;
+    return roots;
+}
+
+std::vector<double> GaussianQuadrature::getWeights()
+{
+    std::vector<double> weights = getNodes().weights;
+    for (double& weight : weights) weight *= scale_;
+    return weights;
+}
 
 double GaussianQuadrature::integrate(const std::function<double(double)>& f)
 {
     compute();
+    const std::vector<double>& roots = nodes_->roots;
+    const std::vector<double>& weights = nodes_->weights;
     double integral = 0.0;
-    for (int i = 0; i < points_; i++){integral += weights_[i] * f(roots_[i]);}
-    return integral;
+    for (std::size_t i = 0; i < roots.size(); i++){integral += weights[i] * f(shift_ + scale_ * roots[i]);}
+    return scale_ * integral;
 }
 
-void GaussianQuadrature::setPoints(int points){points_=std::max(2, points); computed_=false; setWeigts({}); setRoots({});}
-void GaussianQuadrature::setWeigts(std::vector<double> weights){weights_ = weights;}
-void GaussianQuadrature::setRoots(std::vector<double> roots){roots_ = roots;}
-void GaussianQuadrature::setIsCompute(bool value){computed_ = value;}
+Eigen::Ref<const Eigen::VectorXd> GaussianQuadrature::getMappedRoots()
+{
+    const std::vector<double>& roots = getNodes().roots;
+    Eigen::Map<const Eigen::VectorXd> cached(roots.data(), roots.size());
+    if (shift_ == 0.0 && scale_ == 1.0) return cached;
+    mappedRoots_ = shift_ + scale_ * cached.array();
+    return mappedRoots_;
+}
+
+const Eigen::VectorXd& GaussianQuadrature::evaluateBatch(const BatchFunction& f)
+{
+    Eigen::Ref<const Eigen::VectorXd> roots = getMappedRoots();
+    values_.resize(roots.size());
+    f(roots, values_);
+    return values_;
+}
+
+double GaussianQuadrature::integrate(const BatchFunction& f)
+{
+    const Eigen::VectorXd& values = evaluateBatch(f);
+    const std::vector<double>& weights = nodes_->weights;
+    return scale_ * Eigen::Map<const Eigen::VectorXd>(weights.data(), weights.size()).dot(values);
+}
+
+void GaussianQuadrature::integrate(const MatrixFunction& f, Eigen::Ref<Eigen::VectorXd> integrals)
+{
+    Eigen::Ref<const Eigen::VectorXd> roots = getMappedRoots();
+    const std::vector<double>& weights = nodes_->weights;
+    matrixValues_.resize(roots.size(), integrals.size());
+    f(roots, matrixValues_);
+    integrals.noalias() = scale_ * (matrixValues_.transpose() * Eigen::Map<const Eigen::VectorXd>(weights.data(), weights.size()));
+}
+
+void GaussianQuadrature::setPoints(int points){points_=std::max(2, points); nodes_.reset();}
 
 void GaussianQuadrature::compute()
 {
     if (!isComputed()){
-        _compute(); 
-        setIsCompute(true); 
+        nodes_ = QuadratureNodeCache::get(typeid(*this), points_, getParameter(), [this]() {return computeNodes();});
     }
 }
 
-GaussLaguerreQuadrature::GaussLaguerreQuadrature(int points): GaussianQuadrature(points){compute();}
+IntervalQuadrature::IntervalQuadrature(int points, double lower, double upper): GaussianQuadrature(points){setInterval(lower, upper);}
+
+double IntervalQuadrature::getLower() const{return lower_;}
+double IntervalQuadrature::getUpper() const{return upper_;}
 
-void GaussLaguerreQuadrature::_compute()
+void IntervalQuadrature::setInterval(double lower, double upper)
 {
-    int points = getPoints();
-    Eigen::MatrixXd J = Eigen::MatrixXd::Zero(points, points);
+    lower_ = lower;
+    upper_ = upper;
+    setAffineMap(0.5 * (lower + upper), 0.5 * (upper - lower));
+}
+
+GaussLaguerreQuadrature::GaussLaguerreQuadrature(int points, double alpha): GaussianQuadrature(points), alpha_(alpha)
+{
+    if (!(alpha > -1.0)) throw MathErrorRegistry::Quadrature::InvalidLaguerreAlphaError();
+    compute();
+}
+
+double GaussLaguerreQuadrature::getAlpha() const{return alpha_;}
+double GaussLaguerreQuadrature::getParameter() const{return alpha_;}
 
-    for (int k = 0; k < points; k++)
+QuadratureNodes GaussLaguerreQuadrature::computeNodes() const
+{
+    int points = getPoints();
+    for (const QuadratureTables::Table& table : QuadratureTables::gaussLaguerre)
     {
-        J(k, k) = 2.0 * k + 1.0;
+        if (table.points == points && alpha_ == 0.0) return {std::vector<double>(table.roots, table.roots + points), std::vector<double>(table.weights, table.weights + points), {}};
     }
 
-    for (int k = 0; k < points - 1; k++)
+    std::vector<double> diagonal(points), offDiagonal(points - 1);
+    for (int k = 0; k < points; k++) diagonal[k] = 2.0 * k + 1.0 + alpha_;
+    for (int k = 0; k < points - 1; k++) offDiagonal[k] = std::sqrt((k + 1.0) * (k + 1.0 + alpha_));
+    return computeGolubWelsch(diagonal, offDiagonal, std::tgamma(alpha_ + 1.0));
+}
+
+GaussHermiteQuadrature::GaussHermiteQuadrature(int points): GaussianQuadrature(points){compute();}
+
+QuadratureNodes GaussHermiteQuadrature::computeNodes() const
+{
+    int points = getPoints();
+    std::vector<double> diagonal(points, 0.0), offDiagonal(points - 1);
+    for (int k = 0; k < points - 1; k++) offDiagonal[k] = std::sqrt(0.5 * (k + 1.0));
+    // Mass sqrt(pi) of the weight exp(-x^2).
+    return computeGolubWelsch(diagonal, offDiagonal, 1.7724538509055160272981674833411452);
+}
+
+GaussLegendreQuadrature::GaussLegendreQuadrature(int points, double lower, double upper): IntervalQuadrature(points, lower, upper){compute();}
+
+QuadratureNodes GaussLegendreQuadrature::computeNodes() const
+{
+    int points = getPoints();
+    std::vector<double> diagonal(points, 0.0), offDiagonal(points - 1);
+    for (int k = 0; k < points - 1; k++) offDiagonal[k] = (k + 1.0) / std::sqrt(4.0 * (k + 1.0) * (k + 1.0) - 1.0);
+    return computeGolubWelsch(diagonal, offDiagonal, 2.0);
+}
+
+GaussKronrodQuadrature::GaussKronrodQuadrature(int points, double lower, double upper): IntervalQuadrature(points, lower, upper){compute();}
+
+std::vector<double> GaussKronrodQuadrature::getGaussWeights()
+{
+    std::vector<double> weights = getNodes().embeddedWeights;
+    for (double& weight : weights) weight *= getScale();
+    return weights;
+}
+
+double GaussKronrodQuadrature::integrate(const std::function<double(double)>& f, double& error)
+{
+    const QuadratureNodes& nodes = getNodes();
+    double shift = getShift(), scale = getScale();
+    // Values of f are kept on the stack: the largest rule has 21 nodes.
+    double values[21];
+    for (std::size_t i = 0; i < nodes.roots.size(); i++) values[i] = f(shift + scale * nodes.roots[i]);
+    return estimateIntegral(values, error);
+}
+
+double GaussKronrodQuadrature::integrate(const BatchFunction& f, double& error){return estimateIntegral(evaluateBatch(f).data(), error);}
+
+double GaussKronrodQuadrature::estimateIntegral(const double* values, double& error)
+{
+    const QuadratureNodes& nodes = getNodes();
+    double scale = getScale();
+    std::size_t n = nodes.roots.size();
+    double kronrod = 0.0, gauss = 0.0, absolute = 0.0;
+    for (std::size_t i = 0; i < n; i++)
     {
-        double b = k + 1.0;
-        J(k, k + 1) = b;
-        J(k + 1, k) = b;
+        kronrod += nodes.weights[i] * values[i];
+        gauss += nodes.embeddedWeights[i] * values[i];
+        absolute += nodes.weights[i] * std::abs(values[i]);
     }
+    double mean = 0.5 * kronrod, variation = 0.0;
+    for (std::size_t i = 0; i < n; i++) variation += nodes.weights[i] * std::abs(values[i] - mean);
 
-    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> solver(J);
-    Eigen::VectorXd roots = solver.eigenvalues();
-    std::vector<double> weights(points);
-    Eigen::MatrixXd V = solver.eigenvectors();
-    for (int i = 0; i < points; i++)
+    double halfLength = std::abs(scale);
+    absolute *= halfLength;
+    variation *= halfLength;
+    error = std::abs((kronrod - gauss) * scale);
+    if (variation != 0.0 && error != 0.0) error = variation * std::min(1.0, std::pow(200.0 * error / variation, 1.5));
+    const double epsilon = std::numeric_limits<double>::epsilon();
+    if (absolute > std::numeric_limits<double>::min() / (50.0 * epsilon)) error = std::max(50.0 * epsilon * absolute, error);
+    return kronrod * scale;
+}
+
+QuadratureNodes GaussKronrodQuadrature::computeNodes() const
+{
+    // QUADPACK qk15 and qk21: Kronrod abscissae on [0, 1] from the largest, Gauss nodes at the odd indices.
+    static const double kronrodRoots15[8] = {
+        0.991455371120812639206854697526329, 0.949107912342758524526189684047851, 0.864864423359769072789712788640926,
+        0.741531185599394439863864773280788, 0.586087235467691130294144845693013, 0.405845151377397166906606412076961,
+        0.207784955007898467600689403773245, 0.000000000000000000000000000000000};
+    static const double kronrodWeights15[8] = {
+        0.022935322010529224963732008058970, 0.063092092629978553290700663189204, 0.104790010322250183839876322541518,
+        0.140653259715525918745189590510238, 0.169004726639267902826583426598550, 0.190350578064785409913256402421014,
+        0.204432940075298892414161999234649, 0.209482141084727828012999174891714};
+    static const double gaussWeights7[4] = {
+        0.129484966168869693270611432679082, 0.279705391489276667901467771423780, 0.381830050505118944950369775488975,
+        0.417959183673469387755102040816327};
+    static const double kronrodRoots21[11] = {
+        0.995657163025808080735527280689003, 0.973906528517171720077964012084452, 0.930157491355708226001207180059508,
+        0.865063366688984510732096688423493, 0.780817726586416897063717578345042, 0.679409568299024406234327365114874,
+        0.562757134668604683339000099272694, 0.433395394129247190799265943165784, 0.294392862701460198131126603103866,
+        0.148874338981631210884826001129720, 0.000000000000000000000000000000000};
+    static const double kronrodWeights21[11] = {
+        0.011694638867371874278064396062192, 0.032558162307964727478818972459390, 0.054755896574351996031381300244580,
+        0.075039674810919952767043140916190, 0.093125454583697605535065465083366, 0.109387158802297641899210590325805,
+        0.123491976262065851077208980478500, 0.134709217311473325928054001771707, 0.142775938577060080797094273138717,
+        0.147739104901338491374841515972068, 0.149445554002916905664936468389821};
+    static const double gaussWeights10[5] = {
+        0.066671344308688137593568809893332, 0.149451349150580593145776339657697, 0.219086362515982043995534934228163,
+        0.269266719309996355091226921569469, 0.295524224714752870173892994651338};
+
+    const double* roots;
+    const double* weights;
+    const double* gaussWeights;
+    switch (getPoints()) {
+        case 7: roots = kronrodRoots15; weights = kronrodWeights15; gaussWeights = gaussWeights7; break;
+        case 10: roots = kronrodRoots21; weights = kronrodWeights21; gaussWeights = gaussWeights10; break;
+        default: throw MathErrorRegistry::Quadrature::UnsupportedKronrodRuleError();
+    }
+
+    // Ascending nodes: the negative half mirrored, then the positive half.
+    int half = getPoints() + 1, size = 2 * getPoints() + 1;
+    QuadratureNodes nodes{std::vector<double>(size), std::vector<double>(size), std::vector<double>(size, 0.0)};
+    for (int j = 0; j < half; j++)
     {
-        weights[i] = std::pow(V(0, i), 2);
+        for (int i : {j, size - 1 - j})
+        {
+            nodes.roots[i] = i == j ? -roots[j] : roots[j];
+            nodes.weights[i] = weights[j];
+            if (j % 2 == 1) nodes.embeddedWeights[i] = gaussWeights[j / 2];
+        }
     }
-    setWeigts(weights); 
-    setRoots(std::vector<double>(roots.data(), roots.data() + roots.size()));
+    return nodes;
+}
+
+AdaptiveQuadrature::AdaptiveQuadrature(double absoluteTolerance, double relativeTolerance, int numberThreads): 
+rule_(7), absoluteTolerance_(absoluteTolerance), relativeTolerance_(relativeTolerance), maxSubintervals_(1000), 
+error_(NAN), numberEvaluations_(0), numberSubintervals_(0), timeTaken_(0.0), converged_(false)
+{
+    if (numberThreads != 1) pool_ = std::make_shared<ThreadPool>(numberThreads);
 }
 
+void AdaptiveQuadrature::setAbsoluteTolerance(double tolerance){absoluteTolerance_ = tolerance;}
+void AdaptiveQuadrature::setRelativeTolerance(double tolerance){relativeTolerance_ = tolerance;}
+void AdaptiveQuadrature::setMaxSubintervals(int maxSubintervals){maxSubintervals_ = std::max(1, maxSubintervals);}
+void AdaptiveQuadrature::setRule(int gaussPoints){rule_ = GaussKronrodQuadrature(gaussPoints);}
+
+double AdaptiveQuadrature::getAbsoluteTolerance() const{return absoluteTolerance_;}
+double AdaptiveQuadrature::getRelativeTolerance() const{return relativeTolerance_;}
+int AdaptiveQuadrature::getMaxSubintervals() const{return maxSubintervals_;}
+int AdaptiveQuadrature::getRule() const{return rule_.getPoints();}
+int AdaptiveQuadrature::getNumberThreads() const{return pool_ ? pool_->getNumberThreads() : 1;}
+double AdaptiveQuadrature::getError() const{return error_;}
+int AdaptiveQuadrature::getNumberEvaluations() const{return numberEvaluations_;}
+int AdaptiveQuadrature::getNumberSubintervals() const{return numberSubintervals_;}
+double AdaptiveQuadrature::getTimeTaken() const{return timeTaken_;}
+bool AdaptiveQuadrature::isConverged() const{return converged_;}
+
+double AdaptiveQuadrature::getTolerance(double integral) const{return std::max(absoluteTolerance_, relativeTolerance_ * std::abs(integral));}
+
+template<typename Function>
+void AdaptiveQuadrature::evaluate(const Function& f, std::vector<Interval>& intervals, int n)
+{
+    if (!pool_ || n == 1) {
+        for (int j = 0; j < n; j++) {
+            rule_.setInterval(intervals[j].lower, intervals[j].upper);
+            intervals[j].integral = rule_.integrate(f, intervals[j].error);
+        }
+        return;
+    }
+    // Copies of the rule share its cached nodes, each task moves its own interval.
+    pool_->parallelFor(n, [this, &f, &intervals](int j) {
+        GaussKronrodQuadrature rule(rule_);
+        rule.setInterval(intervals[j].lower, intervals[j].upper);
+        intervals[j].integral = rule.integrate(f, intervals[j].error);
+    });
+}
+
+double AdaptiveQuadrature::integrate(const std::function<double(double)>& f, double lower, double upper){return refine(f, lower, upper);}
+double AdaptiveQuadrature::integrate(const GaussianQuadrature::BatchFunction& f, double lower, double upper){return refine(f, lower, upper);}
+
+template<typename Function>
+double AdaptiveQuadrature::refine(const Function& f, double lower, double upper)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+    int ruleEvaluations = 2 * rule_.getPoints() + 1;
+
+    heap_.assign(1, Interval{lower, upper, 0.0, 0.0});
+    evaluate(f, heap_, 1);
+    numberEvaluations_ = ruleEvaluations;
+    numberSubintervals_ = 1;
+    double integral = heap_[0].integral, error = heap_[0].error;
+    // Intervals too short to be bisected in floating point are set aside, their contribution stays in the totals.
+    std::vector<Interval> finals;
+
+    while (error > getTolerance(integral) && numberSubintervals_ < maxSubintervals_ && !heap_.empty())
+    {
+        int batch = std::min({getNumberThreads(), static_cast<int>(heap_.size()), maxSubintervals_ - numberSubintervals_});
+        bisected_.resize(batch);
+        halves_.resize(2 * batch);
+        for (int i = 0; i < batch; i++)
+        {
+            std::pop_heap(heap_.begin(), heap_.end());
+            bisected_[i] = heap_.back();
+            heap_.pop_back();
+            double middle = 0.5 * (bisected_[i].lower + bisected_[i].upper);
+            halves_[2 * i] = Interval{bisected_[i].lower, middle, 0.0, 0.0};
+            halves_[2 * i + 1] = Interval{middle, bisected_[i].upper, 0.0, 0.0};
+        }
+        evaluate(f, halves_, 2 * batch);
+        numberEvaluations_ += 2 * batch * ruleEvaluations;
+        numberSubintervals_ += batch;
+
+        for (int i = 0; i < batch; i++)
+        {
+            integral += halves_[2 * i].integral + halves_[2 * i + 1].integral - bisected_[i].integral;
+            error += halves_[2 * i].error + halves_[2 * i + 1].error - bisected_[i].error;
+            for (const Interval& half : {halves_[2 * i], halves_[2 * i + 1]})
+            {
+                double middle = 0.5 * (half.lower + half.upper);
+                if (half.lower < middle && middle < half.upper) {
+                    heap_.push_back(half);
+                    std::push_heap(heap_.begin(), heap_.end());
+                } else {
+                    finals.push_back(half);
+                }
+            }
+        }
+    }
+
+    // Totals summed again: the running sums accumulate rounding over the updates.
+    integral = 0.0;
+    error = 0.0;
+    for (const std::vector<Interval>* intervals : {&heap_, &finals})
+    {
+        for (const Interval& interval : *intervals) {integral += interval.integral; error += interval.error;}
+    }
+    error_ = error;
+    converged_ = error <= getTolerance(integral);
+    auto end = std::chrono::high_resolution_clock::now();
+    timeTaken_ = std::chrono::duration<double>(end - start).count();
+    return integral;
+}
 
@@ -0,0 +1,107 @@
+#include "../include/core-math/surfaceinterpolation.hpp"
+
+SurfaceInterpolation::SurfaceInterpolation(const std::vector<double>& strikes, const std::vector<double>& expiries, const Eigen::Ref<const Eigen::MatrixXd>& values, const Method& method):
+strikes_(strikes), expiries_(expiries), method_(method)
+{
+    if (values.rows() != static_cast<int>(expiries.size()) || values.cols() != static_cast<int>(strikes.size()))
+        throw MathErrorRegistry::CurveInterpolation::MismatchVectorSizeError();
+    for (const std::vector<double>* knots : {&strikes_, &expiries_})
+    {
+        if (knots->size() < 2) throw MathErrorRegistry::CurveInterpolation::WrongVectorSizeError();
+        for (std::size_t i = 1; i < knots->size(); i++)
+        {
+            if (!((*knots)[i] > (*knots)[i - 1])) throw MathErrorRegistry::CurveInterpolation::UnsortedKnotsError();
+        }
+    }
+    classSetter(values);
+}
+
+void SurfaceInterpolation::classSetter(const Eigen::Ref<const Eigen::MatrixXd>& values)
+{
+    int m = getNumberStrikes(), n = getNumberExpiries();
+    rows_.resize(n * m);
+    weights_.resize(n * n);
+    std::vector<double> y(m);
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < m; ++j) {y[j] = values(i, j);}
+        buildSegments(strikes_, y, rows_.data() + i * m);
+    }
+    // Cardinal curves, transposed so that the weights of one expiry segment are contiguous.
+    std::vector<Segment> cardinal(n);
+    y.assign(n, 0.0);
+    for (int i = 0; i < n; ++i) {
+        y[i] = 1.0;
+        buildSegments(expiries_, y, cardinal.data());
+        for (int k = 0; k < n; ++k) {weights_[k * n + i] = cardinal[k];}
+        y[i] = 0.0;
+    }
+}
+
+void SurfaceInterpolation::buildSegments(const std::vector<double>& x, const std::vector<double>& y, Segment* out) const
+{
+    int n = x.size();
+    if (method_ == Method::BICUBIC)
+    {
+        for (int i = 0; i < n; ++i) {out[i] = Segment{y[i], 0.0, 0.0, 0.0};}
+        CurvePolicy::Cubic::build(x.data(), out, n);
+        return;
+    }
+    std::vector<CurvePolicy::Linear::Segment> linear(n);
+    for (int i = 0; i < n; ++i) {linear[i].a = y[i];}
+    CurvePolicy::Linear::build(x.data(), linear.data(), n);
+    for (int i = 0; i < n; ++i) {out[i] = Segment{linear[i].a, linear[i].b, 0.0, 0.0};}
+}
+
+int SurfaceInterpolation::findIndex(const std::vector<double>& knots, double x)
+{
+    // Segment i covers [x_i, x_{i+1}), the last knot being its own segment, as for CurveInterpolation.
+    return std::upper_bound(knots.begin(), knots.end() - 1, x) - knots.begin() - 1 + (x >= knots.back());
+}
+
+bool SurfaceInterpolation::isInRange(double strike, double expiry) const
+{
+    return strike >= strikes_.front() && strike <= strikes_.back() && expiry >= expiries_.front() && expiry <= expiries_.back();
+}
+
+double SurfaceInterpolation::evaluatePoint(double strike, double expiry) const
+{
+    int m = getNumberStrikes(), n = getNumberExpiries();
+    int j = findIndex(strikes_, strike), k = findIndex(expiries_, expiry);
+    double dx = strike - strikes_[j], dt = expiry - expiries_[k];
+    // Bilinear cardinal curves are hat functions: only the two rows around the expiry contribute.
+    int first = method_ == Method::BICUBIC ? 0 : k;
+    int last = method_ == Method::BICUBIC ? n : std::min(k + 2, n);
+    const Segment* weights = weights_.data() + k * n;
+    double result = 0.0;
+    for (int i = first; i < last; ++i) {
+        result += CurvePolicy::Cubic::value(weights[i], dt) * CurvePolicy::Cubic::value(rows_[i * m + j], dx);
+    }
+    return result;
+}
+
+double SurfaceInterpolation::evaluate(double strike, double expiry) const
+{
+    if (!isInRange(strike, expiry)) throw MathErrorRegistry::CurveInterpolation::OutOfRangeCurveInterpolationError();
+    return evaluatePoint(strike, expiry);
+}
+
+bool SurfaceInterpolation::evaluate(const std::vector<double>& strikes, const std::vector<double>& expiries, std::vector<double>& out) const
+{
+    if (strikes.size() != expiries.size()) throw MathErrorRegistry::CurveInterpolation::MismatchVectorSizeError();
+    out.resize(strikes.size());
+    bool inRange = true;
+    for (std::size_t k = 0; k < strikes.size(); ++k)
+    {
+        if (!isInRange(strikes[k], expiries[k])) {out[k] = NAN; inRange = false; continue;}
+        out[k] = evaluatePoint(strikes[k], expiries[k]);
+    }
+    return inRange;
+}
+
+SurfaceInterpolation::Method SurfaceInterpolation::getMethod() const {return method_;}
+int SurfaceInterpolation::getNumberStrikes() const {return strikes_.size();}
+int SurfaceInterpolation::getNumberExpiries() const {return expiries_.size();}
+double SurfaceInterpolation::getLowerBoundStrike() const {return strikes_.front();}
+double SurfaceInterpolation::getUpperBoundStrike() const {return strikes_.back();}
+double SurfaceInterpolation::getLowerBoundExpiry() const {return expiries_.front();}
+double SurfaceInterpolation::getUpperBoundExpiry() const {return expiries_.back();}
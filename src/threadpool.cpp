@@ -0,0 +1,152 @@
+#include "../include/core-math/threadpool.hpp"
+
+namespace
+{
+    // Pool and queue of the calling thread when it is a worker, so that nested submissions stay local.
+    thread_local const ThreadPool* currentPool = nullptr;
+    thread_local int currentQueue = -1;
+
+    // Tasks in progress on the calling thread, innermost last. A waiting task is flagged so that wait()
+    // neither waits for it nor counts it twice when a task it runs meanwhile waits as well.
+    struct RunningTask
+    {
+        const ThreadPool* pool;
+        bool waiting;
+    };
+    thread_local std::vector<RunningTask> runningTasks;
+}
+
+ThreadPool::ThreadPool(int numberThreads): queued_(0), pending_(0), waiting_(0), next_(0), stop_(false), error_(nullptr)
+{
+    if (numberThreads <= 0) numberThreads = std::max(1u, std::thread::hardware_concurrency());
+    for (int i = 0; i < numberThreads; ++i) {queues_.push_back(std::make_unique<Queue>());}
+    for (int i = 0; i < numberThreads; ++i) {workers_.emplace_back(&ThreadPool::workerLoop, this, i);}
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    condition_.notify_all();
+    for (std::thread& worker : workers_) {worker.join();}
+}
+
+int ThreadPool::getNumberThreads() const {return workers_.size();}
+
+int ThreadPool::getCurrentQueue() const {return currentPool == this ? currentQueue : -1;}
+
+void ThreadPool::submit(std::function<void()> task)
+{
+    int index = getCurrentQueue();
+    if (index < 0) index = next_++ % queues_.size();
+    pending_++;
+    {
+        std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+        queues_[index]->tasks.push_back(std::move(task));
+    }
+    {
+        // Publishing under the pool mutex so that a worker about to sleep cannot miss the task.
+        std::lock_guard<std::mutex> lock(mutex_);
+        queued_++;
+    }
+    condition_.notify_one();
+}
+
+bool ThreadPool::runTask(int index)
+{
+    std::function<void()> task;
+    int n = queues_.size();
+    int start = index < 0 ? 0 : index;
+    for (int k = 0; k < n && !task; ++k) {
+        Queue& queue = *queues_[(start + k) % n];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) continue;
+        // Own tasks newest first (still warm in cache), stolen ones oldest first.
+        if (k == 0 && index >= 0) {task = std::move(queue.tasks.back()); queue.tasks.pop_back();}
+        else {task = std::move(queue.tasks.front()); queue.tasks.pop_front();}
+    }
+    if (!task) return false;
+    queued_--;
+    runningTasks.push_back({this, false});
+    try {
+        task();
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!error_) error_ = std::current_exception();
+    }
+    runningTasks.pop_back();
+    if (--pending_ <= waiting_) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        condition_.notify_all();
+    }
+    return true;
+}
+
+void ThreadPool::workerLoop(int index)
+{
+    currentPool = this;
+    currentQueue = index;
+    while (true) {
+        if (runTask(index)) continue;
+        std::unique_lock<std::mutex> lock(mutex_);
+        condition_.wait(lock, [this]() {return stop_ || queued_ > 0;});
+        if (stop_ && queued_ == 0) return;
+    }
+}
+
+void ThreadPool::waitFor(const std::function<bool()>& done)
+{
+    int index = getCurrentQueue();
+    while (!done()) {
+        if (runTask(index)) continue;
+        // Nothing left to run: the remaining tasks are in progress on other threads.
+        std::unique_lock<std::mutex> lock(mutex_);
+        condition_.wait_for(lock, std::chrono::milliseconds(1), [this, &done]() {return done() || queued_ > 0;});
+    }
+}
+
+void ThreadPool::wait()
+{
+    // The tasks of this pool running on the calling thread cannot finish before wait() returns.
+    std::vector<int> flagged;
+    for (int i = 0; i < static_cast<int>(runningTasks.size()); ++i) {
+        if (runningTasks[i].pool != this || runningTasks[i].waiting) continue;
+        runningTasks[i].waiting = true;
+        flagged.push_back(i);
+    }
+    waiting_ += flagged.size();
+    waitFor([this]() {return pending_ <= waiting_;});
+    for (int i : flagged) {runningTasks[i].waiting = false;}
+    waiting_ -= flagged.size();
+    std::exception_ptr error;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::swap(error, error_);
+    }
+    if (error) std::rethrow_exception(error);
+}
+
+void ThreadPool::parallelFor(int n, const std::function<void(int)>& f)
+{
+    std::atomic<int> remaining(n);
+    std::exception_ptr error;
+    std::mutex errorMutex;
+    for (int i = 0; i < n; ++i) {
+        submit([&, i]() {
+            try {
+                f(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!error) error = std::current_exception();
+            }
+            if (--remaining == 0) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                condition_.notify_all();
+            }
+        });
+    }
+    waitFor([&remaining]() {return remaining == 0;});
+    if (error) std::rethrow_exception(error);
+}
@@ -1,5 +1,10 @@
 #include <iostream>
 #include <cassert>
+#include <chrono>
+#include <numeric>
+#include <algorithm>
+#include <random>
+#include <type_traits>
 #include "../include/core-math/curveinterpolation.hpp"
 
 void test_interpolation()
@@ -62,10 +67,739 @@ void test_interpolation()
 
 
 
+}
+
+void test_batch_evaluation()
+{
+    std::map<double, double> testData = {
+        {1.0, 2.0},
+        {2.0, 3.0},
+        {3.0, 5.0},
+        {4.0, 7.0},
+        {5.0, 11.0}
+    };
+    LinearInterpolation linear(testData);
+    CubicSpline cubic(testData);
+
+    std::cout << "Testing batched evaluation..." << std::endl;
+
+    std::vector<double> x = {1.0, 1.5, 2.0, 2.25, 3.0, 3.7, 4.0, 4.999, 5.0};
+    std::vector<double> out;
+    for (const CurveInterpolation* curve : {static_cast<const CurveInterpolation*>(&linear), static_cast<const CurveInterpolation*>(&cubic)})
+    {
+        assert(curve->evaluate(x, out));
+        assert(out.size() == x.size());
+        for (std::size_t i = 0; i < x.size(); i++) assert(out[i] == curve->evaluate(x[i]));
+        assert(curve->evaluateFirstDerivative(x, out));
+        for (std::size_t i = 0; i < x.size(); i++) assert(out[i] == curve->evaluateFirstDerivative(x[i]));
+        assert(curve->evaluateSecondDerivative(x, out));
+        for (std::size_t i = 0; i < x.size(); i++) assert(out[i] == curve->evaluateSecondDerivative(x[i]));
+    }
+
+    // Out-of-range points are flagged and set to NAN, the others are still evaluated
+    std::vector<double> mixed = {0.5, 2.5, 6.0, NAN};
+    assert(!cubic.evaluate(mixed, out));
+    assert(std::isnan(out[0]) && std::isnan(out[2]) && std::isnan(out[3]));
+    assert(out[1] == cubic.evaluate(2.5));
+
+    std::cout << "Batched Evaluation Tests Passed!" << std::endl;
+}
+
+void test_batch_evaluation_time()
+{
+    std::map<double, double> data;
+    for (int i = 0; i <= 1000; i++) data[i * 0.01] = std::sin(i * 0.01);
+    CubicSpline cubic(data);
+
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> uniform(0.0, 10.0);
+    std::vector<double> x(1000000);
+    for (double& xi : x) xi = uniform(gen);
+    std::vector<double> out(x.size());
+
+    auto start = std::chrono::high_resolution_clock::now();
+    double sum = 0.0;
+    for (double xi : x) sum += cubic.evaluate(xi);
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> scalar = end - start;
+
+    start = std::chrono::high_resolution_clock::now();
+    cubic.evaluate(x, out);
+    end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> batch = end - start;
+
+    std::cout << "Time taken to evaluate " << x.size() << " points (scalar): " << scalar.count() << " seconds" << std::endl;
+    std::cout << "Time taken to evaluate " << x.size() << " points (batch): " << batch.count() << " seconds" << std::endl;
+    assert(std::abs(sum - std::accumulate(out.begin(), out.end(), 0.0)) < 1e-6);
+}
+
+void test_cursor()
+{
+    std::map<double, double> data;
+    for (int i = 0; i <= 200; i++) data[i * 0.05 + 0.001 * (i % 7)] = std::cos(i * 0.05);
+    CubicSpline cubic(data);
+    LinearInterpolation linear(data);
+
+    std::cout << "Testing cursor evaluation..." << std::endl;
+
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<double> uniform(cubic.getLowerBoundX(), cubic.getUpperBoundX());
+    std::vector<double> x(5000);
+    for (double& xi : x) xi = uniform(gen);
+    std::vector<double> sorted = x;
+    std::sort(sorted.begin(), sorted.end());
+    std::vector<double> reversed(sorted.rbegin(), sorted.rend());
+
+    for (const CurveInterpolation* curve : {static_cast<const CurveInterpolation*>(&linear), static_cast<const CurveInterpolation*>(&cubic)})
+    {
+        // Sorted, reversed and random walks must all match the binary search results
+        for (const std::vector<double>& points : {sorted, reversed, x})
+        {
+            CurveInterpolation::Cursor cursor = curve->getCursor();
+            for (double xi : points)
+            {
+                assert(cursor.evaluate(xi) == curve->evaluate(xi));
+                assert(cursor.evaluateFirstDerivative(xi) == curve->evaluateFirstDerivative(xi));
+                assert(cursor.evaluateSecondDerivative(xi) == curve->evaluateSecondDerivative(xi));
+            }
+        }
+        CurveInterpolation::Cursor cursor = curve->getCursor();
+        std::vector<double> out, expected;
+        assert(cursor.evaluate(sorted, out));
+        curve->evaluate(sorted, expected);
+        assert(out == expected);
+        for (double knot : {curve->getLowerBoundX(), curve->getUpperBoundX()})
+        {
+            assert(cursor.evaluate(knot) == curve->evaluate(knot));
+        }
+    }
+
+    CurveInterpolation::Cursor cursor = cubic.getCursor();
+    try {
+        cursor.evaluate(cubic.getUpperBoundX() + 1.0);
+        assert(false);
+    } catch (const MathErrorRegistry::CurveInterpolation::OutOfRangeCurveInterpolationError &e) {
+        std::cout << e.what() << std::endl;
+    }
+
+    std::cout << "Cursor Evaluation Tests Passed!" << std::endl;
+}
+
+void test_cursor_time()
+{
+    std::map<double, double> data;
+    for (int i = 0; i <= 100000; i++) data[i * 0.001] = std::sin(i * 0.001);
+    CubicSpline cubic(data);
+
+    std::vector<double> grid(1000000);
+    for (std::size_t i = 0; i < grid.size(); i++) grid[i] = 100.0 * i / (grid.size() - 1);
+    std::vector<double> out, expected;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    cubic.evaluate(grid, expected);
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> batch = end - start;
+
+    start = std::chrono::high_resolution_clock::now();
+    CurveInterpolation::Cursor cursor = cubic.getCursor();
+    cursor.evaluate(grid, out);
+    end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> walk = end - start;
+
+    std::cout << "Time taken to evaluate a sorted grid of " << grid.size() << " points (binary search): " << batch.count() << " seconds" << std::endl;
+    std::cout << "Time taken to evaluate a sorted grid of " << grid.size() << " points (cursor): " << walk.count() << " seconds" << std::endl;
+    assert(out == expected);
+}
+
+void test_lookup_methods()
+{
+    std::cout << "Testing knot lookup methods..." << std::endl;
+
+    std::map<double, double> uniformData, irregularData;
+    std::mt19937 gen(11);
+    std::uniform_real_distribution<double> spacing(0.01, 1.0);
+    double knot = 0.0;
+    for (int i = 0; i <= 300; i++)
+    {
+        uniformData[0.1 * i] = std::sin(0.1 * i);
+        irregularData[knot] = std::sin(knot);
+        knot += spacing(gen) * spacing(gen);
+    }
+    LinearInterpolation uniform(uniformData);
+    CubicSpline irregular(irregularData);
+    assert(uniform.getLookupMethod() == CurveInterpolation::LookupMethod::UNIFORM_GRID);
+    assert(irregular.getLookupMethod() == CurveInterpolation::LookupMethod::BINARY_SEARCH);
+
+    std::vector<double> x;
+    for (int i = 0; i <= 20000; i++) x.push_back(-1.0 + i * (irregular.getUpperBoundX() + 2.0) / 20000);
+    for (const auto& imap : irregularData) x.push_back(imap.first);
+    for (const auto& imap : uniformData) x.push_back(imap.first);
+
+    std::vector<double> expectedUniform, expectedIrregular, out;
+    uniform.setLookupMethod(CurveInterpolation::LookupMethod::BINARY_SEARCH);
+    uniform.evaluate(x, expectedUniform);
+    irregular.evaluate(x, expectedIrregular);
+    for (auto method : {CurveInterpolation::LookupMethod::UNIFORM_GRID, CurveInterpolation::LookupMethod::BUCKET_TABLE})
+    {
+        uniform.setLookupMethod(method);
+        irregular.setLookupMethod(method);
+        uniform.evaluate(x, out);
+        for (std::size_t i = 0; i < x.size(); i++) assert(out[i] == expectedUniform[i] || std::isnan(out[i]));
+        irregular.evaluate(x, out);
+        for (std::size_t i = 0; i < x.size(); i++) assert(out[i] == expectedIrregular[i] || std::isnan(out[i]));
+    }
+
+    std::cout << "Knot Lookup Tests Passed!" << std::endl;
+}
+
+void test_lookup_methods_time()
+{
+    std::mt19937 gen(3);
+    std::uniform_real_distribution<double> spacing(0.5, 1.5);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::vector<double> x(200000), out;
+
+    for (int knots : {10, 100, 1000, 10000, 100000, 1000000})
+    {
+        std::map<double, double> uniformData, irregularData;
+        double knot = 0.0;
+        for (int i = 0; i < knots; i++)
+        {
+            uniformData.emplace_hint(uniformData.end(), i, 0.5 * i);
+            irregularData.emplace_hint(irregularData.end(), knot, 0.5 * i);
+            knot += spacing(gen);
+        }
+        LinearInterpolation uniform(uniformData);
+        LinearInterpolation irregular(irregularData);
+
+        std::cout << knots << " knots:";
+        for (LinearInterpolation* curve : {&uniform, &irregular})
+        {
+            for (double& xi : x) xi = curve->getLowerBoundX() + unit(gen) * (curve->getUpperBoundX() - curve->getLowerBoundX());
+            auto methods = {CurveInterpolation::LookupMethod::BINARY_SEARCH, 
+                curve == &uniform ? CurveInterpolation::LookupMethod::UNIFORM_GRID : CurveInterpolation::LookupMethod::BUCKET_TABLE};
+            for (auto method : methods)
+            {
+                curve->setLookupMethod(method);
+                auto start = std::chrono::high_resolution_clock::now();
+                curve->evaluate(x, out);
+                auto end = std::chrono::high_resolution_clock::now();
+                std::chrono::duration<double> elapsed = end - start;
+                const char* name = method == CurveInterpolation::LookupMethod::BINARY_SEARCH ? "binary search" 
+                    : method == CurveInterpolation::LookupMethod::UNIFORM_GRID ? "uniform grid" : "bucket table";
+                std::cout << " " << name << " " << elapsed.count() << "s";
+            }
+        }
+        std::cout << " (" << x.size() << " random points)" << std::endl;
+    }
+}
+
+void test_spline_random_access_time()
+{
+    std::mt19937 gen(5);
+    std::uniform_real_distribution<double> spacing(0.5, 1.5);
+    std::map<double, double> data;
+    double knot = 0.0;
+    for (int i = 0; i < 1000000; i++) {data.emplace_hint(data.end(), knot, std::sin(0.01 * i)); knot += spacing(gen);}
+    CubicSpline cubic(data);
+    cubic.setLookupMethod(CurveInterpolation::LookupMethod::BUCKET_TABLE);
+
+    std::uniform_real_distribution<double> uniform(cubic.getLowerBoundX(), cubic.getUpperBoundX());
+    std::vector<double> x(1000000), out;
+    for (double& xi : x) xi = uniform(gen);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    cubic.evaluate(x, out);
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> elapsed = end - start;
+    std::cout << "Time taken for " << x.size() << " random spline evaluations on " << data.size() << " knots: " << elapsed.count() << " seconds" << std::endl;
+}
+
+void test_spline_update()
+{
+    std::cout << "Testing spline value updates..." << std::endl;
+
+    std::map<double, double> data;
+    for (int i = 0; i <= 50; i++) data[i * 0.3 + 0.01 * (i % 3)] = std::exp(-0.05 * i);
+    CubicSpline cubic(data);
+
+    std::vector<double> x;
+    for (int i = 0; i <= 1000; i++) x.push_back(cubic.getLowerBoundX() + i * (cubic.getUpperBoundX() - cubic.getLowerBoundX()) / 1000);
+    std::vector<double> out, expected;
+
+    // Single knot bumps, including both boundaries
+    for (int index : {0, 17, 50})
+    {
+        auto it = std::next(data.begin(), index);
+        it->second += 0.01;
+        cubic.updateValue(index, it->second);
+        CubicSpline rebuilt(data);
+        cubic.evaluate(x, out);
+        rebuilt.evaluate(x, expected);
+        assert(out == expected);
+        assert(cubic.getInitialData() == data);
+    }
+
+    // Full curve update
+    std::vector<double> values;
+    for (auto& imap : data) {imap.second = std::cos(imap.first); values.push_back(imap.second);}
+    cubic.updateValues(values);
+    CubicSpline rebuilt(data);
+    cubic.evaluateSecondDerivative(x, out);
+    rebuilt.evaluateSecondDerivative(x, expected);
+    assert(out == expected);
+
+    try {
+        cubic.updateValue(51, 0.0);
+        assert(false);
+    } catch (const MathErrorRegistry::CurveInterpolation::InvalidKnotIndexError &e) {
+        std::cout << e.what() << std::endl;
+    }
+    try {
+        cubic.updateValues({1.0, 2.0});
+        assert(false);
+    } catch (const MathErrorRegistry::CurveInterpolation::MismatchVectorSizeError &e) {
+        std::cout << e.what() << std::endl;
+    }
+
+    std::cout << "Spline Update Tests Passed!" << std::endl;
+}
+
+void test_spline_update_time()
+{
+    std::map<double, double> data;
+    for (int i = 0; i < 500; i++) data[i * 0.1] = std::sin(i * 0.1);
+    CubicSpline cubic(data);
+    int bumps = 10000;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int k = 0; k < bumps; k++)
+    {
+        data[(k % 500) * 0.1] += 1e-4;
+        CubicSpline rebuilt(data);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> rebuild = end - start;
+
+    start = std::chrono::high_resolution_clock::now();
+    for (int k = 0; k < bumps; k++) cubic.updateValue(k % 500, std::sin((k % 500) * 0.1) + 1e-4 * (k / 500 + 1));
+    end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> update = end - start;
+
+    std::cout << "Time taken for " << bumps << " knot bumps on 500 knots (rebuild): " << rebuild.count() << " seconds" << std::endl;
+    std::cout << "Time taken for " << bumps << " knot bumps on 500 knots (in-place update): " << update.count() << " seconds" << std::endl;
+}
+
+void test_spline_jacobian()
+{
+    std::cout << "Testing spline jacobian..." << std::endl;
+
+    std::map<double, double> data;
+    for (int i = 0; i <= 30; i++) data[i * 0.5 + 0.05 * (i % 4)] = std::log(1.0 + i);
+    CubicSpline cubic(data);
+    std::vector<double> x;
+    for (int i = 0; i <= 400; i++) x.push_back(cubic.getLowerBoundX() + i * (cubic.getUpperBoundX() - cubic.getLowerBoundX()) / 400);
+
+    Eigen::MatrixXd jacobian;
+    assert(cubic.evaluateJacobian(x, jacobian));
+    assert(jacobian.rows() == static_cast<int>(x.size()) && jacobian.cols() == static_cast<int>(data.size()));
+
+    // The spline is linear in the knot values: bumps reproduce the jacobian columns
+    std::vector<double> base, bumped;
+    cubic.evaluate(x, base);
+    double bump = 1e-3;
+    for (int i = 0; i < static_cast<int>(data.size()); i++)
+    {
+        double y = std::next(data.begin(), i)->second;
+        cubic.updateValue(i, y + bump);
+        cubic.evaluate(x, bumped);
+        cubic.updateValue(i, y);
+        for (std::size_t j = 0; j < x.size(); j++) assert(std::abs((bumped[j] - base[j]) / bump - jacobian(j, i)) < 1e-9);
+    }
+    // A parallel shift of every value shifts the spline by the same amount
+    for (int j = 0; j < jacobian.rows(); j++) assert(std::abs(jacobian.row(j).sum() - 1.0) < 1e-12);
+
+    Eigen::MatrixXd outOfRange;
+    assert(!cubic.evaluateJacobian({cubic.getLowerBoundX() - 1.0, x[10]}, outOfRange));
+    assert(std::isnan(outOfRange(0, 0)));
+    assert(outOfRange.row(1) == jacobian.row(10));
+
+    std::cout << "Spline Jacobian Tests Passed!" << std::endl;
+}
+
+void test_spline_jacobian_time()
+{
+    std::map<double, double> data;
+    for (int i = 0; i < 200; i++) data[i * 0.1] = std::sin(i * 0.1);
+    CubicSpline cubic(data);
+    std::vector<double> x, base, bumped;
+    for (int i = 0; i < 1000; i++) x.push_back(i * 19.9 / 999);
+    cubic.evaluate(x, base);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    Eigen::MatrixXd ladder(x.size(), data.size());
+    for (int i = 0; i < static_cast<int>(data.size()); i++)
+    {
+        std::map<double, double> bumpedData = data;
+        std::next(bumpedData.begin(), i)->second += 1e-4;
+        CubicSpline rebuilt(bumpedData);
+        rebuilt.evaluate(x, bumped);
+        for (std::size_t j = 0; j < x.size(); j++) ladder(j, i) = (bumped[j] - base[j]) / 1e-4;
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> rebuild = end - start;
+
+    start = std::chrono::high_resolution_clock::now();
+    Eigen::MatrixXd jacobian;
+    cubic.evaluateJacobian(x, jacobian);
+    end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> solve = end - start;
+
+    std::cout << "Time taken for a 200 knots x 1000 points risk ladder (bump and rebuild): " << rebuild.count() << " seconds" << std::endl;
+    std::cout << "Time taken for a 200 knots x 1000 points risk ladder (jacobian): " << solve.count() << " seconds" << std::endl;
+    assert((ladder - jacobian).cwiseAbs().maxCoeff() < 1e-6);
+}
+
+void test_array_construction()
+{
+    std::cout << "Testing construction from arrays..." << std::endl;
+
+    std::vector<double> x = {1.0, 2.0, 3.0, 4.0, 5.0};
+    std::vector<double> y = {2.0, 3.0, 5.0, 7.0, 11.0};
+    std::map<double, double> testData;
+    for (std::size_t i = 0; i < x.size(); i++) testData[x[i]] = y[i];
+
+    LinearInterpolation linear(testData);
+    CubicSpline cubic(testData);
+    LinearInterpolation linearVector(x, y);
+    CubicSpline cubicVector(x, y);
+    Eigen::VectorXd xEigen = Eigen::Map<Eigen::VectorXd>(x.data(), x.size());
+    Eigen::VectorXd yEigen = Eigen::Map<Eigen::VectorXd>(y.data(), y.size());
+    LinearInterpolation linearEigen(xEigen, yEigen);
+    CubicSpline cubicEigen(xEigen, yEigen);
+    // Non-owning view over external memory, as for memory-mapped curve snapshots
+    LinearInterpolation linearView(Eigen::Map<const Eigen::VectorXd>(x.data(), x.size()), Eigen::Map<const Eigen::VectorXd>(y.data(), y.size()), CurveInterpolation::Storage::BORROWED);
+    CubicSpline cubicView(Eigen::Map<const Eigen::VectorXd>(x.data(), x.size()), Eigen::Map<const Eigen::VectorXd>(y.data(), y.size()), CurveInterpolation::Storage::BORROWED);
+    // Strided rows: the Ref holds a temporary copy of each row, which the curves copy in turn
+    Eigen::MatrixXd grid(2, x.size());
+    grid.row(0) = xEigen.transpose();
+    grid.row(1) = yEigen.transpose();
+    LinearInterpolation linearRow(grid.row(0).transpose(), grid.row(1).transpose());
+    CubicSpline cubicRow(grid.row(0).transpose(), grid.row(1).transpose());
+    // Only a Map can be borrowed
+    static_assert(!std::is_constructible<LinearInterpolation, decltype(grid.row(0).transpose()), decltype(grid.row(1).transpose()), CurveInterpolation::Storage>::value, 
+                  "strided expressions must not be borrowed");
+
+    std::vector<double> points = {1.0, 1.3, 2.5, 3.0, 4.75, 5.0};
+    std::vector<double> expected, out;
+    linear.evaluate(points, expected);
+    for (const CurveInterpolation* curve : {&linearVector, &linearEigen, &linearView, &linearRow})
+    {
+        curve->evaluate(points, out);
+        assert(out == expected);
+        assert(curve->getInitialData() == testData);
+        assert(curve->getNumberKnots() == 5);
+    }
+    cubic.evaluate(points, expected);
+    for (const CurveInterpolation* curve : {&cubicVector, &cubicEigen, &cubicView, &cubicRow})
+    {
+        curve->evaluate(points, out);
+        assert(out == expected);
+        assert(curve->getInitialData() == testData);
+    }
+
+    // The view reads the borrowed values, the owned copies do not
+    y[2] = 6.0;
+    assert(linearView.evaluate(3.0) == 6.0);
+    assert(linearEigen.evaluate(3.0) == 5.0);
+
+    try {
+        LinearInterpolation unsorted({1.0, 3.0, 2.0}, {1.0, 2.0, 3.0});
+        assert(false);
+    } catch (const MathErrorRegistry::CurveInterpolation::UnsortedKnotsError &e) {
+        std::cout << e.what() << std::endl;
+    }
+    try {
+        CubicSpline mismatch({1.0, 2.0, 3.0}, {1.0, 2.0});
+        assert(false);
+    } catch (const MathErrorRegistry::CurveInterpolation::MismatchVectorSizeError &e) {
+        std::cout << e.what() << std::endl;
+    }
+
+    std::cout << "Array Construction Tests Passed!" << std::endl;
+}
+
+void test_array_construction_time()
+{
+    int knots = 1000000;
+    std::vector<double> x(knots), y(knots);
+    for (int i = 0; i < knots; i++) {x[i] = i * 0.01; y[i] = std::sin(i * 0.01);}
+
+    auto start = std::chrono::high_resolution_clock::now();
+    std::map<double, double> data;
+    for (int i = 0; i < knots; i++) data.emplace_hint(data.end(), x[i], y[i]);
+    LinearInterpolation fromMap(data);
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> map = end - start;
+
+    start = std::chrono::high_resolution_clock::now();
+    LinearInterpolation fromVector(x, y);
+    end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> vector = end - start;
+
+    start = std::chrono::high_resolution_clock::now();
+    LinearInterpolation view(Eigen::Map<const Eigen::VectorXd>(x.data(), knots), Eigen::Map<const Eigen::VectorXd>(y.data(), knots), CurveInterpolation::Storage::BORROWED);
+    end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> borrowed = end - start;
+
+    std::cout << "Time taken to build a " << knots << " knots curve (map): " << map.count() << " seconds" << std::endl;
+    std::cout << "Time taken to build a " << knots << " knots curve (vectors): " << vector.count() << " seconds" << std::endl;
+    std::cout << "Time taken to build a " << knots << " knots curve (borrowed view): " << borrowed.count() << " seconds" << std::endl;
+}
+
+void test_additional_engines()
+{
+    std::cout << "Testing monotone cubic, Akima and log-linear engines..." << std::endl;
+
+    // Monotone data with a sharp step, where the natural spline overshoots
+    std::vector<double> x = {0.0, 1.0, 2.0, 3.0, 4.0, 5.0, 6.0};
+    std::vector<double> y = {0.0, 0.0, 0.1, 5.0, 5.1, 5.1, 6.0};
+    MonotoneCubicSpline monotone(x, y);
+    AkimaSpline akima(x, y);
+    CubicSpline cubic(x, y);
+    for (std::size_t i = 0; i < x.size(); i++)
+    {
+        assert(std::abs(monotone.evaluate(x[i]) - y[i]) < 1e-12);
+        assert(std::abs(akima.evaluate(x[i]) - y[i]) < 1e-12);
+    }
+    std::vector<double> points, out, derivatives;
+    for (int i = 0; i <= 600; i++) points.push_back(i * 0.01);
+    monotone.evaluate(points, out);
+    monotone.evaluateFirstDerivative(points, derivatives);
+    for (std::size_t i = 1; i < points.size(); i++) 
+    {
+        assert(out[i] >= out[i - 1] - 1e-14);
+        assert(derivatives[i] >= -1e-12);
+    }
+    bool overshoot = false;
+    cubic.evaluate(points, out);
+    for (std::size_t i = 1; i < points.size(); i++) overshoot = overshoot || out[i] < out[i - 1];
+    assert(overshoot);
+    // Flat data stay flat
+    assert(monotone.evaluate(4.5) == 5.1);
+    assert(monotone.evaluateFirstDerivative(0.5) == 0.0);
+
+    // Akima reproduces linear data, derivatives included
+    std::vector<double> line(x.size());
+    for (std::size_t i = 0; i < x.size(); i++) line[i] = 2.0 - 0.5 * x[i];
+    AkimaSpline akimaLine(x, line);
+    MonotoneCubicSpline monotoneLine(x, line);
+    for (double point : points)
+    {
+        assert(std::abs(akimaLine.evaluate(point) - (2.0 - 0.5 * point)) < 1e-12);
+        assert(std::abs(akimaLine.evaluateFirstDerivative(point) + 0.5) < 1e-12);
+        assert(std::abs(akimaLine.evaluateSecondDerivative(point)) < 1e-12);
+        assert(std::abs(monotoneLine.evaluate(point) - (2.0 - 0.5 * point)) < 1e-12);
+    }
+    // Continuity of the first derivative at the knots
+    for (std::size_t i = 1; i + 1 < x.size(); i++)
+    {
+        assert(std::abs(akima.evaluateFirstDerivative(x[i] - 1e-9) - akima.evaluateFirstDerivative(x[i])) < 1e-6);
+        assert(std::abs(monotone.evaluateFirstDerivative(x[i] - 1e-9) - monotone.evaluateFirstDerivative(x[i])) < 1e-6);
+    }
+
+    // Log-linear on discount factors: piecewise constant forward rates
+    std::vector<double> times = {0.0, 0.5, 1.0, 2.0, 5.0};
+    std::vector<double> rates = {0.01, 0.015, 0.02, 0.03};
+    std::vector<double> discount = {1.0};
+    for (std::size_t i = 0; i < rates.size(); i++) discount.push_back(discount.back() * std::exp(-rates[i] * (times[i + 1] - times[i])));
+    LogLinearInterpolation logLinear(times, discount);
+    for (std::size_t i = 0; i < times.size(); i++) assert(std::abs(logLinear.evaluate(times[i]) - discount[i]) < 1e-15);
+    double value = logLinear.evaluate(1.5);
+    assert(std::abs(value - discount[2] * std::exp(-0.02 * 0.5)) < 1e-15);
+    assert(std::abs(logLinear.evaluateFirstDerivative(1.5) / value + 0.02) < 1e-12);
+    assert(std::abs(logLinear.evaluateSecondDerivative(1.5) / value - 0.02 * 0.02) < 1e-12);
+    assert(std::abs(logLinear.evaluateFirstDerivative(5.0) / logLinear.evaluate(5.0) + 0.03) < 1e-12);
+
+    // Same batched path, cursor and views as the other engines
+    std::vector<double> expected;
+    Eigen::Map<const Eigen::VectorXd> xView(times.data(), times.size()), yView(discount.data(), discount.size());
+    LogLinearInterpolation logLinearView(xView, yView, CurveInterpolation::Storage::BORROWED);
+    std::vector<double> curvePoints = {0.0, 0.25, 0.7, 1.5, 3.3, 5.0};
+    logLinear.evaluate(curvePoints, expected);
+    logLinearView.getCursor().evaluate(curvePoints, out);
+    assert(out == expected);
+    curvePoints.push_back(5.5);
+    assert(!logLinear.evaluate(curvePoints, out) && std::isnan(out.back()));
+
+    try {
+        LogLinearInterpolation negative({0.0, 1.0, 2.0}, {1.0, 0.0, 0.5});
+        assert(false);
+    } catch (const MathErrorRegistry::CurveInterpolation::NonPositiveValueError &e) {
+        std::cout << e.what() << std::endl;
+    }
+
+    std::cout << "Additional Engines Tests Passed!" << std::endl;
+}
+
+template <typename T>
+void report_engine_time(const std::string& name, const std::vector<double>& x, const std::vector<double>& y, const std::vector<double>& points)
+{
+    int repeats = 20;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int r = 0; r < repeats; r++) T curve(x, y);
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> construction = end - start;
+
+    T curve(x, y);
+    std::vector<double> out;
+    start = std::chrono::high_resolution_clock::now();
+    curve.evaluate(points, out);
+    end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> evaluation = end - start;
+
+    std::cout << name << ": construction of " << x.size() << " knots " << construction.count() / repeats 
+    << " seconds, " << points.size() / evaluation.count() / 1e6 << " million points per second" << std::endl;
+}
+
+void test_engines_time()
+{
+    int knots = 10000, size = 2000000;
+    std::vector<double> x(knots), y(knots);
+    for (int i = 0; i < knots; i++) {x[i] = i * 0.01 + 0.001 * (i % 7); y[i] = std::exp(-0.03 * x[i]) * (1.0 + 0.1 * std::sin(x[i]));}
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> distribution(x.front(), x.back());
+    std::vector<double> points(size);
+    for (double& point : points) point = distribution(generator);
+
+    report_engine_time<LinearInterpolation>("Linear", x, y, points);
+    report_engine_time<CubicSpline>("Cubic spline", x, y, points);
+    report_engine_time<MonotoneCubicSpline>("Monotone cubic", x, y, points);
+    report_engine_time<AkimaSpline>("Akima", x, y, points);
+    report_engine_time<LogLinearInterpolation>("Log-linear", x, y, points);
+}
+
+void test_basic_curve()
+{
+    std::cout << "Testing BasicCurve..." << std::endl;
+
+    // Fixed-size curves are literal types: built and evaluated at compile time
+    constexpr BasicCurve<CurvePolicy::Linear, 3> constantLinear({0.0, 1.0, 3.0}, {1.0, 3.0, 4.0});
+    static_assert(constantLinear.evaluate(0.5) == 2.0, "constexpr linear evaluation");
+    static_assert(constantLinear.evaluate(3.0) == 4.0, "constexpr evaluation at the last knot");
+    static_assert(constantLinear.evaluateFirstDerivative(2.0) == 0.5, "constexpr linear derivative");
+    constexpr BasicCurve<CurvePolicy::Cubic, 4> constantCubic({0.0, 1.0, 2.0, 3.0}, {0.0, 1.0, 0.0, 1.0});
+    static_assert(constantCubic.evaluate(1.0) == 1.0 && constantCubic.evaluateSecondDerivative(0.0) == 0.0, "constexpr natural spline");
+
+    std::vector<double> x = {1.0, 1.5, 2.0, 3.0, 4.0, 5.5, 6.0, 8.0};
+    std::vector<double> y = {2.0, 2.5, 3.0, 5.0, 4.0, 6.0, 6.5, 9.0};
+    CubicSpline cubic(x, y);
+    LinearInterpolation linear(x, y);
+    BasicCurve<CurvePolicy::Cubic, 8> cubicFixed(x, y);
+    BasicCurve<CurvePolicy::Cubic> cubicDynamic(x, y);
+    BasicCurve<CurvePolicy::Linear, 8> linearFixed(x, y);
+    std::vector<double> points, expected, out;
+    for (int i = 0; i <= 700; i++) points.push_back(1.0 + i * 0.01);
+    for (double point : points)
+    {
+        // Same kernels and same arithmetic as the virtual classes
+        assert(cubicFixed.evaluate(point) == cubic.evaluate(point));
+        assert(cubicDynamic.evaluate(point) == cubic.evaluate(point));
+        assert(cubicFixed.evaluateFirstDerivative(point) == cubic.evaluateFirstDerivative(point));
+        assert(cubicFixed.evaluateSecondDerivative(point) == cubic.evaluateSecondDerivative(point));
+        assert(linearFixed.evaluate(point) == linear.evaluate(point));
+        assert(linearFixed.evaluateFirstDerivative(point) == linear.evaluateFirstDerivative(point));
+    }
+    points.push_back(9.0);
+    assert(!cubic.evaluate(points, expected));
+    assert(!cubicDynamic.evaluate(points, out) && std::isnan(out.back()));
+    out.pop_back();
+    expected.pop_back();
+    assert(out == expected);
+    assert(cubicDynamic.getNumberKnots() == 8 && cubicFixed.getLowerBoundX() == 1.0 && cubicFixed.getUpperBoundX() == 8.0);
+
+    try {
+        cubicFixed.evaluate(0.5);
+        assert(false);
+    } catch (const MathErrorRegistry::CurveInterpolation::OutOfRangeCurveInterpolationError &e) {
+        std::cout << e.what() << std::endl;
+    }
+    try {
+        BasicCurve<CurvePolicy::Linear, 4> wrongSize(x, y);
+        assert(false);
+    } catch (const MathErrorRegistry::CurveInterpolation::MismatchVectorSizeError &e) {
+        std::cout << e.what() << std::endl;
+    }
+
+    std::cout << "BasicCurve Tests Passed!" << std::endl;
+}
+
+template <int N>
+void report_basic_curve_time(const std::vector<double>& points)
+{
+    std::vector<double> x(N), y(N);
+    for (int i = 0; i < N; i++) {x[i] = i + 0.3 * std::sin(i); y[i] = std::exp(-0.05 * i);}
+    std::vector<double> shifted(points.size());
+    for (std::size_t k = 0; k < points.size(); k++) shifted[k] = x[0] + points[k] * (x[N - 1] - x[0]);
+
+    CubicSpline spline(x, y);
+    BasicCurve<CurvePolicy::Cubic, N> fixed(x, y);
+    BasicCurve<CurvePolicy::Cubic> dynamic(x, y);
+
+    double sumVirtual = 0.0, sumFixed = 0.0, sumDynamic = 0.0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (double point : shifted) sumVirtual += spline.evaluate(point);
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> virtualPath = end - start;
+
+    start = std::chrono::high_resolution_clock::now();
+    for (double point : shifted) sumFixed += fixed.evaluate(point);
+    end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> fixedPath = end - start;
+
+    start = std::chrono::high_resolution_clock::now();
+    for (double point : shifted) sumDynamic += dynamic.evaluate(point);
+    end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> dynamicPath = end - start;
+    assert(sumFixed == sumVirtual && sumDynamic == sumVirtual);
+
+    std::cout << "Time taken for " << points.size() << " scalar evaluations on " << N << " knots (CubicSpline): " << virtualPath.count() << " seconds" << std::endl;
+    std::cout << "Time taken for " << points.size() << " scalar evaluations on " << N << " knots (BasicCurve<Cubic, " << N << ">): " << fixedPath.count() << " seconds" << std::endl;
+    std::cout << "Time taken for " << points.size() << " scalar evaluations on " << N << " knots (BasicCurve<Cubic>): " << dynamicPath.count() << " seconds" << std::endl;
+}
+
+void test_basic_curve_time()
+{
+    int size = 5000000;
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> distribution(0.0, 1.0);
+    std::vector<double> points(size);
+    for (double& point : points) point = distribution(generator);
+
+    report_basic_curve_time<8>(points);
+    report_basic_curve_time<16>(points);
+    report_basic_curve_time<32>(points);
 }
 
 int main()
 {
     test_interpolation();
+    test_batch_evaluation();
+    test_batch_evaluation_time();
+    test_cursor();
+    test_cursor_time();
+    test_lookup_methods();
+    test_lookup_methods_time();
+    test_spline_random_access_time();
+    test_spline_update();
+    test_spline_update_time();
+    test_spline_jacobian();
+    test_spline_jacobian_time();
+    test_array_construction();
+    test_array_construction_time();
+    test_additional_engines();
+    test_engines_time();
+    test_basic_curve();
+    test_basic_curve_time();
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,199 @@
+#include <iostream>
+#include <cmath>
+#include <cassert>
+#include <chrono>
+#include "../include/core-math/finitedifference.hpp"
+
+// f(x) = sum_i exp(x_i) sin(x_{i+1}) + x_i^2, written once for real and complex arguments.
+template<typename Scalar>
+Scalar chainFunction(const Eigen::Ref<const Eigen::Matrix<Scalar, Eigen::Dynamic, 1>>& x)
+{
+    Scalar result = 0.0;
+    for (int i = 0; i < x.size(); i++) result += x[i] * x[i] + (i + 1 < x.size() ? std::exp(x[i]) * std::sin(x[i + 1]) : Scalar(0.0));
+    return result;
+}
+
+Eigen::VectorXd chainGradient(const Eigen::VectorXd& x)
+{
+    Eigen::VectorXd gradient = 2.0 * x;
+    for (int i = 0; i + 1 < x.size(); i++)
+    {
+        gradient[i] += std::exp(x[i]) * std::sin(x[i + 1]);
+        gradient[i + 1] += std::exp(x[i]) * std::cos(x[i + 1]);
+    }
+    return gradient;
+}
+
+// r(x) = (x_0 x_1, sin(x_0) + x_2^3, exp(x_1 - x_2), x_0 + x_1 + x_2)
+template<typename Scalar>
+void residualFunction(const Eigen::Ref<const Eigen::Matrix<Scalar, Eigen::Dynamic, 1>>& x, Eigen::Ref<Eigen::Matrix<Scalar, Eigen::Dynamic, 1>> values)
+{
+    values[0] = x[0] * x[1];
+    values[1] = std::sin(x[0]) + x[2] * x[2] * x[2];
+    values[2] = std::exp(x[1] - x[2]);
+    values[3] = x[0] + x[1] + x[2];
+}
+
+void test_finite_difference_gradient()
+{
+    std::cout << "Testing finite difference gradients..." << std::endl;
+
+    FiniteDifference::Function f = chainFunction<double>;
+    FiniteDifference::ComplexFunction complexF = chainFunction<std::complex<double>>;
+    Eigen::VectorXd x = Eigen::VectorXd::LinSpaced(12, -1.0, 1.5);
+    Eigen::VectorXd expected = chainGradient(x), gradient(12), threaded(12);
+
+    FiniteDifference forward(FiniteDifference::Method::FORWARD);
+    forward.gradient(f, x, gradient);
+    assert((gradient - expected).lpNorm<Eigen::Infinity>() < 1e-6);
+    assert(forward.getNumberEvaluations() == 13);
+    forward.gradient(f, x, f(x), gradient);
+    assert(forward.getNumberEvaluations() == 12);
+
+    FiniteDifference central;
+    assert(central.getMethod() == FiniteDifference::Method::CENTRAL && central.getNumberThreads() == 1);
+    central.gradient(f, x, gradient);
+    assert((gradient - expected).lpNorm<Eigen::Infinity>() < 1e-9);
+    assert(central.getNumberEvaluations() == 24);
+
+    // Complex step: no subtractive cancellation, the gradient is exact to rounding
+    FiniteDifference complexStep(FiniteDifference::Method::COMPLEX_STEP);
+    complexStep.gradient(complexF, x, gradient);
+    assert((gradient - expected).lpNorm<Eigen::Infinity>() < 1e-14);
+    assert(complexStep.getNumberEvaluations() == 12);
+
+    // Complex functions with real steps match the real overload
+    central.gradient(complexF, x, threaded);
+    central.gradient(f, x, gradient);
+    assert(threaded == gradient);
+
+    // Every coordinate is differenced the same way on any number of threads
+    for (FiniteDifference::Method method : {FiniteDifference::Method::FORWARD, FiniteDifference::Method::CENTRAL, FiniteDifference::Method::COMPLEX_STEP})
+    {
+        FiniteDifference sequential(method), parallel(method, 3);
+        assert(parallel.getNumberThreads() == 3);
+        sequential.gradient(complexF, x, gradient);
+        parallel.gradient(complexF, x, threaded);
+        assert(threaded == gradient);
+    }
+    FiniteDifference parallel(FiniteDifference::Method::CENTRAL, 3);
+    parallel.gradient(f, x, threaded);
+    central.gradient(f, x, gradient);
+    assert(threaded == gradient);
+
+    // The step is relative to 1 + |x_j|
+    central.setStep(1e-3);
+    central.gradient(f, x, gradient);
+    assert((gradient - expected).lpNorm<Eigen::Infinity>() > 1e-8);
+    central.setStep(NAN);
+    assert(central.getStep() == std::cbrt(std::numeric_limits<double>::epsilon()));
+
+    try {
+        complexStep.gradient(f, x, gradient);
+        assert(false);
+    } catch (const MathErrorRegistry::FiniteDifference::ComplexStepFunctionError &e) {
+        std::cout << e.what() << std::endl;
+    }
+    try {
+        Eigen::VectorXd wrong(5);
+        central.gradient(f, x, wrong);
+        assert(false);
+    } catch (const MathErrorRegistry::FiniteDifference::MismatchOutputSizeError &e) {
+        std::cout << e.what() << std::endl;
+    }
+
+    std::cout << "Finite Difference Gradient Tests Passed!" << std::endl;
+}
+
+void test_finite_difference_jacobian()
+{
+    std::cout << "Testing finite difference Jacobians..." << std::endl;
+
+    FiniteDifference::VectorFunction f = residualFunction<double>;
+    FiniteDifference::ComplexVectorFunction complexF = residualFunction<std::complex<double>>;
+    Eigen::VectorXd x(3);
+    x << 0.3, -0.7, 1.1;
+    Eigen::MatrixXd expected(4, 3);
+    expected << x[1], x[0], 0.0,
+                std::cos(x[0]), 0.0, 3.0 * x[2] * x[2],
+                0.0, std::exp(x[1] - x[2]), -std::exp(x[1] - x[2]),
+                1.0, 1.0, 1.0;
+    Eigen::MatrixXd jacobian(4, 3), threaded(4, 3);
+
+    FiniteDifference forward(FiniteDifference::Method::FORWARD);
+    forward.jacobian(f, x, jacobian);
+    assert((jacobian - expected).lpNorm<Eigen::Infinity>() < 1e-6);
+    assert(forward.getNumberEvaluations() == 4);
+
+    FiniteDifference central(FiniteDifference::Method::CENTRAL, 2);
+    central.jacobian(f, x, jacobian);
+    assert((jacobian - expected).lpNorm<Eigen::Infinity>() < 1e-9);
+    assert(central.getNumberEvaluations() == 6);
+
+    FiniteDifference complexStep(FiniteDifference::Method::COMPLEX_STEP, 2);
+    complexStep.jacobian(complexF, x, jacobian);
+    assert((jacobian - expected).lpNorm<Eigen::Infinity>() < 1e-15);
+    FiniteDifference sequential(FiniteDifference::Method::COMPLEX_STEP);
+    sequential.jacobian(complexF, x, threaded);
+    assert(threaded == jacobian);
+
+    try {
+        Eigen::MatrixXd wrong(4, 2);
+        forward.jacobian(f, x, wrong);
+        assert(false);
+    } catch (const MathErrorRegistry::FiniteDifference::MismatchOutputSizeError &e) {
+        std::cout << e.what() << std::endl;
+    }
+
+    std::cout << "Finite Difference Jacobian Tests Passed!" << std::endl;
+}
+
+void test_finite_difference_time()
+{
+    // Expensive objective: each call sums a thousand terms.
+    int n = 64;
+    FiniteDifference::Function f = [](const Eigen::Ref<const Eigen::VectorXd>& x) {
+        double result = 0.0;
+        for (int k = 0; k < 1000; k++) result += std::sin(x.sum() + 1e-3 * k) * x.squaredNorm();
+        return result;
+    };
+    Eigen::VectorXd x = Eigen::VectorXd::LinSpaced(n, -1.0, 1.0), gradient(n), threaded(n);
+
+    // Reference: one objective call at a time on a fresh point copy, as the optimizers used to do.
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int j = 0; j < n; j++)
+    {
+        Eigen::VectorXd up = x, down = x;
+        double h = 1e-6 * (1.0 + std::abs(x[j]));
+        up[j] += h;
+        down[j] -= h;
+        gradient[j] = (f(up) - f(down)) / (2.0 * h);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> naive = end - start;
+
+    FiniteDifference sequential;
+    start = std::chrono::high_resolution_clock::now();
+    sequential.gradient(f, x, gradient);
+    end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> single = end - start;
+
+    FiniteDifference parallel(FiniteDifference::Method::CENTRAL, 0);
+    start = std::chrono::high_resolution_clock::now();
+    parallel.gradient(f, x, threaded);
+    end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> pooled = end - start;
+    assert(threaded == gradient);
+
+    std::cout << "Time taken for a central gradient in dimension " << n << " (copied points): " << naive.count() << " seconds" << std::endl;
+    std::cout << "Time taken for a central gradient in dimension " << n << " (1 thread): " << single.count() << " seconds" << std::endl;
+    std::cout << "Time taken for a central gradient in dimension " << n << " (" << parallel.getNumberThreads() << " threads): " << pooled.count() << " seconds" << std::endl;
+}
+
+int main()
+{
+    test_finite_difference_gradient();
+    test_finite_difference_jacobian();
+    test_finite_difference_time();
+    return 0;
+}
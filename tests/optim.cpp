@@ -3,8 +3,27 @@
 #include <memory>
 #include <cmath>
 #include <cassert>
+#include <cstdlib>
+#include <new>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <sstream>
+#include <algorithm>
 #include "../include/core-math/optim.hpp"
 
+// Global allocation counter, to check that the optimizer cores do not allocate once set up. Atomic, as the 
+// batch and multi-threaded optimizers allocate on pool threads.
+static std::atomic<long long> allocationCount{0};
+void* operator new(std::size_t size) 
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* pointer = std::malloc(size)) return pointer;
+    throw std::bad_alloc();
+}
+void operator delete(void* pointer) noexcept {std::free(pointer);}
+void operator delete(void* pointer, std::size_t) noexcept {std::free(pointer);}
+
 // 🔹 Test function for Newton-Raphson: f(x) = x^2 - 4
 double testFunctionNR(double x) {
     return x * x - 4;  // Roots at x = ±2
@@ -113,10 +132,686 @@ void testNelderMeadHimmelblau() {
 }
 
 
+double rosenbrockFunction(std::vector<double> x) {
+    double sum = 0.0;
+    for (std::size_t i = 0; i + 1 < x.size(); i++) {
+        sum += 100.0 * (x[i + 1] - x[i] * x[i]) * (x[i + 1] - x[i] * x[i]) + (1.0 - x[i]) * (1.0 - x[i]);
+    }
+    return sum;
+}
+
+double rosenbrockPointer(const double* x, int n) {
+    double sum = 0.0;
+    for (int i = 0; i + 1 < n; i++) {
+        sum += 100.0 * (x[i + 1] - x[i] * x[i]) * (x[i + 1] - x[i] * x[i]) + (1.0 - x[i]) * (1.0 - x[i]);
+    }
+    return sum;
+}
+
+double rosenbrockEigen(Eigen::Ref<const Eigen::VectorXd> x) {return rosenbrockPointer(x.data(), x.size());}
+
+void testNelderMeadObjectiveSignatures() {
+    std::cout << "Testing Nelder-Mead objective signatures...\n";
+    std::vector<double> x0 = {-1.2, 1.0, 0.5};
+    NelderMead legacy(x0, rosenbrockFunction);
+    NelderMead pointer(x0, rosenbrockPointer);
+    NelderMead eigen(x0, rosenbrockEigen);
+    double offset = 0.0;
+    NelderMead lambda(x0, [&offset](const std::vector<double>& x) {return rosenbrockPointer(x.data(), x.size()) + offset;});
+    std::function<double(std::vector<double>)> wrapped = rosenbrockFunction;
+    NelderMead function(x0, wrapped);
+    for (NelderMead* optimizer : {&legacy, &pointer, &eigen, &lambda, &function}) {
+        optimizer->setMaximumIterations(2000);
+        optimizer->setToleranceThreshold(1e-12);
+    }
+    std::vector<double> expected = legacy.getResult();
+    for (NelderMead* optimizer : {&pointer, &eigen, &lambda, &function}) {
+        long long allocations = allocationCount;
+        optimizer->optimize();
+        allocations = allocationCount - allocations;
+        // Same trajectory whatever the signature
+        assert(optimizer->getResult() == expected);
+        assert(optimizer->getNumberEvaluations() == legacy.getNumberEvaluations());
+        // The zero-copy signatures leave only the setup buffers (the legacy one copies the point per call)
+        if (optimizer != &function) assert(allocations <= 9);
+    }
+    std::cout << "✅ Nelder-Mead Objective Signatures Test Passed!\n\n";
+}
+
+void testNelderMeadRosenbrockTime() {
+    std::cout << "Timing Nelder-Mead on Rosenbrock...\n";
+    for (int n : {2, 5, 10, 20, 50}) {
+        std::vector<double> x0(n, -1.0);
+        NelderMead optimizer(x0, rosenbrockFunction);
+        optimizer.setToleranceThreshold(1e-12);
+        optimizer.setMaximumIterations(20000);
+        long long allocations = allocationCount;
+        optimizer.optimize();
+        allocations = allocationCount - allocations;
+        int evaluations = optimizer.getNumberEvaluations();
+        std::cout << "Dimension " << n << ": " << optimizer.getNumberIterations() << " iterations, f = " << optimizer.getFunctionResult() 
+        << ", " << allocations << " allocations, time taken: " << optimizer.getTimeTaken() << "\n";
+        // Setup sizes the simplex buffers and the result (9 vectors); the std::vector objective signature 
+        // then copies its argument once per evaluation, and nothing else allocates.
+        assert(allocations == 9 + evaluations);
+
+        NelderMead pointerOptimizer(x0, rosenbrockPointer);
+        pointerOptimizer.setToleranceThreshold(1e-12);
+        pointerOptimizer.setMaximumIterations(20000);
+        allocations = allocationCount;
+        pointerOptimizer.optimize();
+        allocations = allocationCount - allocations;
+        std::cout << "Dimension " << n << " (const double* objective): " << allocations << " allocations, time taken: " << pointerOptimizer.getTimeTaken() << "\n";
+        assert(allocations == 9);
+    }
+}
+
+void testBatchOptimizer() {
+    std::cout << "Testing batch optimizer...\n";
+
+    // A list of independent problems. The callables are temporaries: the optimizers keep their own copies.
+    std::vector<std::shared_ptr<Optimizer>> problems;
+    for (int k = 1; k <= 20; k++) {
+        double target = k;
+        problems.push_back(std::make_shared<NewtonRaphson>(1.0, [target](double x) {return x * x - target;}, [](double x) {return 2 * x;}));
+        problems.push_back(std::make_shared<NelderMead>(std::vector<double>{0.0, 0.0}, [target](const double* x, int) {
+            return (x[0] - target) * (x[0] - target) + (x[1] + target) * (x[1] + target);
+        }));
+    }
+    BatchOptimizer batch(problems, 4);
+    const std::vector<BatchOptimizer::Report>& reports = batch.getReports();
+    assert(reports.size() == problems.size());
+    for (int k = 1; k <= 20; k++) {
+        const BatchOptimizer::Report& root = reports[2 * (k - 1)];
+        const BatchOptimizer::Report& minimum = reports[2 * (k - 1) + 1];
+        assert(root.status == BatchOptimizer::Status::COMPLETED && !root.error && root.numberIterations > 1);
+        assert(minimum.status == BatchOptimizer::Status::COMPLETED && minimum.timeTaken >= 0.0);
+        assert(std::abs(std::dynamic_pointer_cast<NewtonRaphson>(batch.getProblem(2 * (k - 1)))->getResult() - std::sqrt(k)) < 1e-6);
+        std::vector<double> x = std::dynamic_pointer_cast<NelderMead>(batch.getProblem(2 * (k - 1) + 1))->getResult();
+        assert(std::abs(x[0] - k) < 1e-3 && std::abs(x[1] + k) < 1e-3);
+    }
+
+    // Multi-start: failures are reported per start, not thrown
+    NewtonRaphson root(1.0, testFunctionNR, testFunctionDerivativeNR);
+    BatchOptimizer roots(root, {-3.0, -1.0, 0.0, 1.0, 3.0});
+    assert(roots.getReports()[2].status == BatchOptimizer::Status::FAILED);
+    try {
+        std::rethrow_exception(roots.getReports()[2].error);
+    } catch (const MathErrorRegistry::Optim::NewtonRaphsonDerivativeZeroError &e) {
+        std::cout << e.what() << "\n";
+    }
+    assert(std::abs(roots.getReports()[roots.getBestIndex()].objectiveValue) < 1e-6);
+
+    std::vector<std::vector<double>> starts;
+    for (int i = -4; i <= 4; i++) for (int j = -4; j <= 4; j++) starts.push_back({1.5 * i, 1.5 * j});
+    NelderMead himmelblau(starts[0], himmelblauFunction);
+    himmelblau.setMaximumIterations(1000);
+    himmelblau.setToleranceThreshold(1e-10);
+    BatchOptimizer multiStart(himmelblau, starts, 4);
+    int best = multiStart.getBestIndex();
+    assert(multiStart.getReports()[best].objectiveValue < 1e-8);
+    for (const BatchOptimizer::Report& report : multiStart.getReports()) assert(report.status == BatchOptimizer::Status::COMPLETED);
+
+    // Early cancellation once a start reaches the target
+    BatchOptimizer cancelled(himmelblau, starts, 2);
+    cancelled.setTargetValue(1e-6);
+    int numberCancelled = 0;
+    for (const BatchOptimizer::Report& report : cancelled.getReports()) numberCancelled += report.status == BatchOptimizer::Status::CANCELLED;
+    assert(cancelled.getReports()[cancelled.getBestIndex()].objectiveValue <= 1e-6);
+    assert(numberCancelled > 0);
+    std::cout << numberCancelled << " of " << starts.size() << " starts cancelled\n";
+
+    // A cancelled run stops at its first iteration and is not reused: the next call starts over
+    std::atomic<bool> stop(true);
+    NelderMead interrupted(himmelblau);
+    interrupted.setCancellationFlag(&stop);
+    interrupted.optimize();
+    assert(!interrupted.isOptimized() && interrupted.getNumberIterations() <= 1);
+    stop = false;
+    interrupted.optimize();
+    assert(interrupted.isOptimized() && interrupted.getObjectiveValue() == multiStart.getReports()[0].objectiveValue);
+    interrupted.setCancellationFlag(nullptr);
+
+    // Without a target, the interrupted starts run again instead of reporting their interrupted results
+    cancelled.setTargetValue(-INFINITY);
+    for (int i = 0; i < cancelled.getNumberProblems(); i++) {
+        assert(cancelled.getReports()[i].status == BatchOptimizer::Status::COMPLETED);
+        assert(cancelled.getReports()[i].objectiveValue == multiStart.getReports()[i].objectiveValue);
+    }
+
+    std::cout << "✅ Batch Optimizer Test Passed!\n\n";
+}
+
+void testBatchOptimizerTime() {
+    int size = 2000;
+    std::vector<std::vector<double>> starts(size);
+    for (int i = 0; i < size; i++) starts[i] = {-2.0 + 4.0 * i / size, 1.0, 0.5, -0.5, 1.5};
+    NelderMead problem(starts[0], rosenbrockPointer);
+    problem.setMaximumIterations(2000);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (const std::vector<double>& x0 : starts) {
+        NelderMead copy(problem);
+        copy.setStartValues(x0);
+        copy.optimize();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> sequential = end - start;
+
+    BatchOptimizer batch(problem, starts);
+    batch.optimize();
+    std::cout << "Time taken for " << size << " Nelder-Mead problems (sequential): " << sequential.count() << "\n";
+    std::cout << "Time taken for " << size << " Nelder-Mead problems (batch, " << std::thread::hardware_concurrency() << " hardware threads): " << batch.getTimeTaken() << "\n";
+}
+
+void testBatchNewtonRaphson() {
+    std::cout << "Testing batch Newton-Raphson...\n";
+
+    // Cube roots of many targets, written as array expressions
+    int n = 1000;
+    Eigen::ArrayXd targets = Eigen::ArrayXd::LinSpaced(n, 0.5, 100.0);
+    BatchNewtonRaphson::Function f = [&targets](const Eigen::Ref<const Eigen::ArrayXd>& x, Eigen::Ref<Eigen::ArrayXd> out) {out = x.cube() - targets;};
+    BatchNewtonRaphson::Function fDeriv = [](const Eigen::Ref<const Eigen::ArrayXd>& x, Eigen::Ref<Eigen::ArrayXd> out) {out = 3.0 * x.square();};
+    BatchNewtonRaphson batch(Eigen::ArrayXd::Constant(n, 2.0), f, fDeriv);
+    batch.setToleranceThreshold(1e-12);
+    batch.setMaximumIterations(100);
+    const Eigen::ArrayXd& roots = batch.getResults();
+    for (int k = 0; k < n; k++) {
+        assert(batch.getStatuses()[k] == BatchNewtonRaphson::Status::CONVERGED);
+        assert(std::abs(roots[k] - std::cbrt(targets[k])) < 1e-9);
+        // Each lane follows the scalar optimizer step for step
+        double target = targets[k];
+        NewtonRaphson scalar(2.0, [target](double x) {return x * x * x - target;}, [](double x) {return 3 * x * x;});
+        scalar.setToleranceThreshold(1e-12);
+        scalar.setMaximumIterations(100);
+        assert(scalar.getResult() == roots[k]);
+    }
+    assert(batch.getNumberIterations() == batch.getLaneIterations().maxCoeff());
+    assert(batch.getObjectiveValue() < 1e-9);
+
+    // Failing lanes are reported by status and do not affect the others
+    Eigen::ArrayXd starts(4);
+    starts << 1.0, 0.0, -1.0, 3.0;
+    BatchNewtonRaphson::Function g = [](const Eigen::Ref<const Eigen::ArrayXd>& x, Eigen::Ref<Eigen::ArrayXd> out) {out = (x > 2.5).select(NAN, x.square() - 4.0);};
+    BatchNewtonRaphson::Function gDeriv = [](const Eigen::Ref<const Eigen::ArrayXd>& x, Eigen::Ref<Eigen::ArrayXd> out) {out = 2.0 * x;};
+    BatchNewtonRaphson mixed(starts, g, gDeriv);
+    mixed.setToleranceThreshold(1e-10);
+    const std::vector<BatchNewtonRaphson::Status>& statuses = mixed.getStatuses();
+    assert(statuses[0] == BatchNewtonRaphson::Status::CONVERGED && std::abs(mixed.getResults()[0] - 2.0) < 1e-9);
+    assert(statuses[1] == BatchNewtonRaphson::Status::DERIVATIVE_ZERO && std::isnan(mixed.getResults()[1]));
+    assert(statuses[2] == BatchNewtonRaphson::Status::CONVERGED && std::abs(mixed.getResults()[2] + 2.0) < 1e-9);
+    assert(statuses[3] == BatchNewtonRaphson::Status::NOT_FINITE && std::isnan(mixed.getResults()[3]));
+    assert(!mixed.getError());
+
+    mixed.setMaximumIterations(2);
+    assert(mixed.getStatuses()[0] == BatchNewtonRaphson::Status::MAXIMUM_ITERATIONS);
+
+    std::cout << "✅ Batch Newton-Raphson Test Passed!\n\n";
+}
+
+void testBatchNewtonRaphsonTime() {
+    int n = 200000;
+    Eigen::ArrayXd targets = Eigen::ArrayXd::LinSpaced(n, 0.5, 100.0);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    double sum = 0.0;
+    for (int k = 0; k < n; k++) {
+        double target = targets[k];
+        NewtonRaphson scalar(2.0, [target](double x) {return x * x * x - target;}, [](double x) {return 3 * x * x;});
+        scalar.setToleranceThreshold(1e-12);
+        sum += scalar.getResult();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> sequential = end - start;
+
+    BatchNewtonRaphson batch(Eigen::ArrayXd::Constant(n, 2.0), 
+        [&targets](const Eigen::Ref<const Eigen::ArrayXd>& x, Eigen::Ref<Eigen::ArrayXd> out) {out = x.cube() - targets;}, 
+        [](const Eigen::Ref<const Eigen::ArrayXd>& x, Eigen::Ref<Eigen::ArrayXd> out) {out = 3.0 * x.square();});
+    batch.setToleranceThreshold(1e-12);
+    batch.optimize();
+    assert(std::abs(batch.getResults().sum() - sum) < 1e-6 * n);
+
+    std::cout << "Time taken for " << n << " cube roots (NewtonRaphson per root): " << sequential.count() << "\n";
+    std::cout << "Time taken for " << n << " cube roots (BatchNewtonRaphson): " << batch.getTimeTaken() << "\n";
+}
+
+struct RootTestFunction {
+    std::string name;
+    double a, b;
+    std::function<double(double)> f, fDeriv, fSecondDeriv;
+};
+
+std::vector<RootTestFunction> getRootTestFunctions() {
+    return {
+        {"x^3 - 2x - 5", 2.0, 3.0, [](double x) {return x * x * x - 2 * x - 5;}, [](double x) {return 3 * x * x - 2;}, [](double x) {return 6 * x;}},
+        {"cos(x) - x", 0.0, 1.0, [](double x) {return std::cos(x) - x;}, [](double x) {return -std::sin(x) - 1;}, [](double x) {return -std::cos(x);}},
+        {"exp(x) - 2", -4.0, 4.0, [](double x) {return std::exp(x) - 2;}, [](double x) {return std::exp(x);}, [](double x) {return std::exp(x);}},
+        {"x^10 - 1", 0.0, 1.3, [](double x) {return std::pow(x, 10) - 1;}, [](double x) {return 10 * std::pow(x, 9);}, [](double x) {return 90 * std::pow(x, 8);}},
+        {"atan(x)", -1.0, 10.0, [](double x) {return std::atan(x);}, [](double x) {return 1 / (1 + x * x);}, [](double x) {return -2 * x / ((1 + x * x) * (1 + x * x));}},
+        {"(x - 1)^3", 0.0, 3.0, [](double x) {return (x - 1) * (x - 1) * (x - 1);}, [](double x) {return 3 * (x - 1) * (x - 1);}, [](double x) {return 6 * (x - 1);}},
+        {"x exp(-x) - 0.1", 0.0, 1.0, [](double x) {return x * std::exp(-x) - 0.1;}, [](double x) {return (1 - x) * std::exp(-x);}, [](double x) {return (x - 2) * std::exp(-x);}},
+        {"sin(x) - x / 2", 1.0, 3.0, [](double x) {return std::sin(x) - x / 2;}, [](double x) {return std::cos(x) - 0.5;}, [](double x) {return -std::sin(x);}},
+    };
+}
+
+void testBracketedRootFinders() {
+    std::cout << "Testing bracketed root finders...\n";
+    for (const RootTestFunction& test : getRootTestFunctions()) {
+        Brent brent(test.a, test.b, test.f);
+        NewtonBisection newton(test.a, test.b, test.f, test.fDeriv);
+        Halley halley(test.a, test.b, test.f, test.fDeriv, test.fSecondDeriv);
+        for (BracketedRootFinder* solver : std::vector<BracketedRootFinder*>{&brent, &newton, &halley}) {
+            solver->setToleranceThreshold(1e-12);
+            solver->setMaximumIterations(200);
+            double root = solver->getResult();
+            assert(!solver->getError());
+            assert(root >= test.a && root <= test.b);
+            // The triple root is flat: |f| < tol is reached about 1e-4 away from it
+            assert(std::abs(test.f(root)) < 1e-10 && std::abs(solver->getFunctionResult() - test.f(root)) == 0.0);
+            assert(solver->getNumberIterations() > 0 && solver->getNumberEvaluations() >= solver->getNumberIterations());
+        }
+    }
+
+    // Flat derivative at the start: NewtonRaphson throws, the safeguarded version bisects
+    NewtonRaphson plain(0.0, testFunctionNR, testFunctionDerivativeNR);
+    assert(std::isnan(plain.getResult()) && plain.getError() != nullptr);
+    NewtonBisection safeguarded(-1.0, 5.0, testFunctionNR, testFunctionDerivativeNR);
+    safeguarded.setStartValue(0.0);
+    assert(std::abs(safeguarded.getResult() - 2.0) < 1e-9);
+
+    // No sign change in the bracket
+    Brent invalid(3.0, 5.0, testFunctionNR);
+    double invalidRoot = invalid.getResult();
+    assert(std::isnan(invalidRoot));
+    try {
+        std::rethrow_exception(invalid.getError());
+    } catch (const MathErrorRegistry::Optim::InvalidBracketError &e) {
+        std::cout << e.what() << "\n";
+    }
+    invalid.setBracket(0.0, 5.0);
+    assert(std::abs(invalid.getResult() - 2.0) < 1e-9 && !invalid.getError());
+
+    std::cout << "✅ Bracketed Root Finders Test Passed!\n\n";
+}
+
+void testRootFinderEvaluations() {
+    std::cout << "Function evaluations (f, f' and f'' calls) to reach |f| < 1e-12 or a step below 1e-12:\n";
+    std::cout << "function | Brent | NewtonBisection | Halley | NewtonRaphson from the middle\n";
+    for (const RootTestFunction& test : getRootTestFunctions()) {
+        Brent brent(test.a, test.b, test.f);
+        NewtonBisection newton(test.a, test.b, test.f, test.fDeriv);
+        Halley halley(test.a, test.b, test.f, test.fDeriv, test.fSecondDeriv);
+        std::cout << test.name;
+        for (BracketedRootFinder* solver : std::vector<BracketedRootFinder*>{&brent, &newton, &halley}) {
+            solver->setToleranceThreshold(1e-12);
+            solver->setMaximumIterations(200);
+            std::cout << " | " << solver->getNumberEvaluations();
+        }
+        NewtonRaphson plain(0.5 * (test.a + test.b), test.f, test.fDeriv);
+        plain.setToleranceThreshold(1e-12);
+        plain.setMaximumIterations(200);
+        double root = plain.getResult();
+        // Two calls (f and f') per iteration
+        if (plain.getError() || !std::isfinite(root) || std::abs(test.f(root)) > 1e-10) std::cout << " | failed\n";
+        else std::cout << " | " << 2 * (plain.getNumberIterations() - 1) << "\n";
+    }
+}
+
+void rosenbrockGradient(const Eigen::Ref<const Eigen::VectorXd>& x, Eigen::Ref<Eigen::VectorXd> gradient) {
+    gradient.setZero();
+    for (int i = 0; i + 1 < x.size(); ++i) {
+        double t = x[i + 1] - x[i] * x[i];
+        gradient[i] += -400.0 * x[i] * t - 2.0 * (1.0 - x[i]);
+        gradient[i + 1] += 200.0 * t;
+    }
+}
+
+void testLBFGS() {
+    std::cout << "Testing L-BFGS on Rosenbrock...\n";
+    for (int n : {2, 10, 50}) {
+        Eigen::VectorXd x0 = Eigen::VectorXd::Constant(n, -1.0);
+        LBFGS analytic(x0, rosenbrockEigen, rosenbrockGradient);
+        analytic.setToleranceThreshold(1e-12);
+        analytic.setMaximumIterations(5000);
+        Eigen::VectorXd result = analytic.getResult();
+        assert(!analytic.getError());
+        assert((result.array() - 1.0).abs().maxCoeff() < 1e-6);
+        assert(analytic.getObjectiveValue() < 1e-12);
+
+        // Same problem again: the work vectors are already sized, so the iterations do not allocate
+        analytic.setMaximumIterations(5000);
+        long long allocations = allocationCount;
+        analytic.optimize();
+        allocations = allocationCount - allocations;
+        assert(allocations == 0);
+
+        LBFGS differences(x0, rosenbrockEigen);
+        differences.setToleranceThreshold(1e-12);
+        differences.setMaximumIterations(5000);
+        assert((differences.getResult().array() - 1.0).abs().maxCoeff() < 1e-4);
+        // The differences are computed coordinate by coordinate, so threads do not change the iterates
+        LBFGS threaded(x0, rosenbrockEigen);
+        threaded.setFiniteDifference(FiniteDifference(FiniteDifference::Method::CENTRAL, 2));
+        threaded.setToleranceThreshold(1e-12);
+        threaded.setMaximumIterations(5000);
+        assert(threaded.getResult() == differences.getResult());
+
+        std::vector<double> start(n, -1.0);
+        NelderMead simplex(start, rosenbrockPointer);
+        simplex.setToleranceThreshold(1e-12);
+        simplex.setMaximumIterations(20000);
+        simplex.optimize();
+        std::cout << "Dimension " << n << ": L-BFGS " << analytic.getNumberEvaluations() << " evaluations (f = " << analytic.getFunctionResult() 
+        << ", " << analytic.getTimeTaken() << " s), with finite differences " << differences.getNumberEvaluations() << " evaluations (f = " 
+        << differences.getFunctionResult() << "), Nelder-Mead " << simplex.getNumberEvaluations() << " evaluations (f = " << simplex.getFunctionResult() 
+        << ", " << simplex.getTimeTaken() << " s)\n";
+    }
+
+    // A gradient pointing the wrong way: no step decreases f, and the stall is reported instead of a result
+    LBFGS wrongGradient(Eigen::VectorXd::Constant(3, 1.0), [](const Eigen::Ref<const Eigen::VectorXd>& x) {return x.squaredNorm();}, 
+        [](const Eigen::Ref<const Eigen::VectorXd>& x, Eigen::Ref<Eigen::VectorXd> gradient) {gradient = -2.0 * x;});
+    OptimizerTrace stalled(100);
+    wrongGradient.setTrace(&stalled);
+    double stalledValue = wrongGradient.getFunctionResult();
+    assert(std::isnan(stalledValue) && wrongGradient.getError());
+    assert(stalled.getRecords().back().step == OptimizerTrace::Step::REJECTED);
+    try {
+        std::rethrow_exception(wrongGradient.getError());
+    } catch (const MathErrorRegistry::Optim::LineSearchError &e) {
+        std::cout << e.what() << "\n";
+    }
+    std::cout << "✅ L-BFGS Test Passed!\n\n";
+}
+
+// Model a * exp(-b t) + c on fixed observation times.
+std::vector<double> getDecayTimes() {
+    std::vector<double> t(40);
+    for (int k = 0; k < 40; ++k) t[k] = 0.25 * k;
+    return t;
+}
+
+void testLevenbergMarquardt() {
+    std::cout << "Testing Levenberg-Marquardt...\n";
+    std::vector<double> t = getDecayTimes();
+    auto model = [t](const Eigen::Ref<const Eigen::VectorXd>& x, Eigen::Ref<Eigen::VectorXd> estimates) {
+        for (std::size_t k = 0; k < t.size(); ++k) estimates[k] = x[0] * std::exp(-x[1] * t[k]) + x[2];
+    };
+    auto jacobian = [t](const Eigen::Ref<const Eigen::VectorXd>& x, Eigen::Ref<Eigen::MatrixXd> J) {
+        for (std::size_t k = 0; k < t.size(); ++k) {
+            double e = std::exp(-x[1] * t[k]);
+            J(k, 0) = e;
+            J(k, 1) = -x[0] * t[k] * e;
+            J(k, 2) = 1.0;
+        }
+    };
+    Eigen::VectorXd parameters(3);
+    parameters << 2.5, 0.7, 0.3;
+    Eigen::VectorXd observed(t.size());
+    model(parameters, observed);
+    Eigen::VectorXd x0(3);
+    x0 << 1.0, 0.1, 0.0;
+
+    // Exact data: the fit recovers the parameters and the residuals vanish
+    LevenbergMarquardt analytic(x0, model, observed, jacobian);
+    analytic.setToleranceThreshold(1e-14);
+    analytic.setMaximumIterations(200);
+    assert((analytic.getResult() - parameters).lpNorm<Eigen::Infinity>() < 1e-8);
+    assert(analytic.getResidualsObject().getRMSE() < 1e-8);
+    analytic.setMaximumIterations(200);
+    long long allocations = allocationCount;
+    analytic.optimize();
+    allocations = allocationCount - allocations;
+    assert(allocations == 0);
+
+    LevenbergMarquardt differences(x0, model, observed);
+    differences.setToleranceThreshold(1e-14);
+    differences.setMaximumIterations(200);
+    assert((differences.getResult() - parameters).lpNorm<Eigen::Infinity>() < 1e-6);
+
+    // Noisy data: same least squares solution as the linearized normal equations at the optimum
+    for (int k = 0; k < observed.size(); ++k) observed[k] += 0.01 * std::sin(7.0 * k);
+    LevenbergMarquardt noisy(x0, model, observed, jacobian);
+    noisy.setToleranceThreshold(1e-14);
+    noisy.setMaximumIterations(200);
+    Eigen::VectorXd fit = noisy.getResult();
+    EstimatorLoss loss = noisy.getResidualsObject();
+    Eigen::MatrixXd J(t.size(), 3);
+    jacobian(fit, J);
+    assert((J.transpose() * loss.getResiduals()).lpNorm<Eigen::Infinity>() < 1e-10);
+    assert(std::abs(noisy.getFunctionResult() - 0.5 * loss.getResiduals().squaredNorm()) < 1e-14);
+    std::cout << "Fit " << fit.transpose() << ", RMSE " << loss.getRMSE() << ", " << noisy.getNumberIterations() << " iterations, " 
+    << noisy.getNumberEvaluations() << " evaluations; finite differences: " << differences.getNumberEvaluations() << " evaluations\n";
+    std::cout << "✅ Levenberg-Marquardt Test Passed!\n\n";
+}
+
+void testOptimizerTrace() {
+    std::cout << "Testing optimizer traces...\n";
+    std::vector<double> x0 = {-1.2, 1.0};
+    NelderMead untraced(x0, rosenbrockPointer);
+    untraced.setToleranceThreshold(1e-10);
+    untraced.setMaximumIterations(2000);
+    assert(untraced.getTrace() == nullptr);
+
+    // The trace sees every iteration, and tracing does not change the iterates
+    int callbacks = 0;
+    OptimizerTrace trace(64, [&callbacks](const OptimizerTrace::Record&) {callbacks++;});
+    NelderMead traced(x0, rosenbrockPointer);
+    traced.setToleranceThreshold(1e-10);
+    traced.setMaximumIterations(2000);
+    traced.setTrace(&trace);
+    assert(traced.getResult() == untraced.getResult());
+    std::vector<OptimizerTrace::Record> records = trace.getRecords();
+    assert(callbacks == records.back().iteration + 1 && callbacks >= traced.getNumberIterations());
+    assert(trace.getSize() == 64 && trace.getNumberDropped() == static_cast<std::size_t>(callbacks - 64));
+    assert(records.back().numberEvaluations == traced.getNumberEvaluations());
+    assert(records.back().bestValue == traced.getFunctionResult());
+    for (std::size_t k = 1; k < records.size(); k++) {
+        assert(records[k].iteration == records[k - 1].iteration + 1);
+        assert(records[k].bestValue <= records[k - 1].bestValue && records[k].elapsedTime >= records[k - 1].elapsedTime);
+    }
+
+    // Step counts over a whole run, shrinks included
+    OptimizerTrace full(10000);
+    NelderMead himmelblau({0.0, 0.0}, himmelblauFunction);
+    himmelblau.setToleranceThreshold(1e-10);
+    himmelblau.setMaximumIterations(2000);
+    himmelblau.setTrace(&full);
+    himmelblau.optimize();
+    std::vector<int> steps(8, 0);
+    for (const OptimizerTrace::Record& record : full.getRecords()) steps[static_cast<int>(record.step)]++;
+    assert(steps[static_cast<int>(OptimizerTrace::Step::INITIAL)] == 1 && full.getRecords().front().numberEvaluations == 3);
+    std::cout << "Himmelblau steps: reflect " << steps[1] << ", expand " << steps[2] << ", contract " << steps[3] << ", shrink " << steps[4] << "\n";
+
+    std::ostringstream csv, json;
+    full.writeCSV(csv);
+    full.writeJSON(json);
+    std::string text = csv.str();
+    assert(text.rfind("iteration,step,best_value,diameter,evaluations,evaluation_time,elapsed_time\n", 0) == 0);
+    assert(std::count(text.begin(), text.end(), '\n') == static_cast<long>(full.getSize()) + 1);
+    assert(json.str().find("\"step\": \"initial\"") != std::string::npos && json.str().back() == '\n');
+
+    // Gradient methods report their line search and damped steps
+    OptimizerTrace gradientTrace(1000);
+    LBFGS lbfgs(Eigen::VectorXd::Constant(5, -1.0), rosenbrockEigen, rosenbrockGradient);
+    lbfgs.setMaximumIterations(500);
+    lbfgs.setTrace(&gradientTrace);
+    lbfgs.optimize();
+    assert(static_cast<int>(gradientTrace.getSize()) == lbfgs.getNumberIterations() + 1);
+    assert(gradientTrace.getRecords().back().step == OptimizerTrace::Step::LINE_SEARCH);
+
+    // Disabled tracing costs a pointer test: time both paths
+    std::vector<double> start(20, -1.0);
+    NelderMead plain(start, rosenbrockPointer), instrumented(start, rosenbrockPointer);
+    OptimizerTrace timing(100000);
+    instrumented.setTrace(&timing);
+    for (NelderMead* optimizer : {&plain, &instrumented}) {
+        optimizer->setToleranceThreshold(1e-12);
+        optimizer->setMaximumIterations(20000);
+        optimizer->optimize();
+    }
+    assert(plain.getResult() == instrumented.getResult());
+    std::cout << "Nelder-Mead in dimension 20, untraced: " << plain.getTimeTaken() << " s, traced: " << instrumented.getTimeTaken() << " s\n";
+    std::cout << "✅ Optimizer Trace Test Passed!\n\n";
+}
+
+void testEvaluationCache() {
+    std::cout << "Testing the evaluation cache...\n";
+    EvaluationCache cache(2, 3);
+    double value = 0.0;
+    std::vector<std::vector<double>> points = {{0.0, 1.0}, {1.0, 0.0}, {2.0, 2.0}, {3.0, -1.0}};
+    for (int k = 0; k < 3; k++) {
+        assert(!cache.find(points[k].data(), value));
+        cache.insert(points[k].data(), 10.0 * k);
+    }
+    assert(cache.getSize() == 3 && cache.find(points[0].data(), value) && value == 0.0);
+    // Full: the least recently used point ({1, 0}, since {0, 1} was just used) is evicted
+    cache.insert(points[3].data(), 30.0);
+    assert(cache.getSize() == 3);
+    assert(!cache.find(points[1].data(), value));
+    assert(cache.find(points[2].data(), value) && value == 20.0);
+    assert(cache.find(points[3].data(), value) && value == 30.0);
+    assert(cache.find(points[0].data(), value) && value == 0.0);
+    // Keys are exact: a point one ulp away is a different point
+    std::vector<double> close = {std::nextafter(0.0, 1.0), 1.0};
+    assert(!cache.find(close.data(), value));
+    assert(cache.getHits() == 4 && cache.getMisses() == 5);
+
+    // Many insertions through a small cache keep the table consistent with the recency order
+    EvaluationCache small(1, 8);
+    for (int k = 0; k < 1000; k++) {
+        double x = k % 13;
+        if (!small.find(&x, value)) small.insert(&x, x * x);
+        else assert(value == x * x);
+    }
+    for (int k = 1000 - 8; k < 1000; k++) {
+        double x = k % 13;
+        assert(small.find(&x, value) && value == x * x);
+    }
+    std::cout << "✅ Evaluation Cache Test Passed!\n\n";
+}
+
+void testNelderMeadCache() {
+    std::cout << "Testing the Nelder-Mead evaluation cache...\n";
+    int calls = 0;
+    auto counted = [&calls](const double* x, int n) {calls++; return rosenbrockPointer(x, n);};
+    std::vector<double> x0 = {-1.2, 1.0, 0.5};
+    NelderMead plain(x0, counted);
+    plain.setToleranceThreshold(1e-12);
+    plain.setMaximumIterations(5000);
+    std::vector<double> expected = plain.getResult();
+    assert(plain.getCacheHits() == 0 && plain.getCacheMisses() == 0 && calls == plain.getNumberEvaluations());
+
+    // Memoization does not change the iterates; the objective runs once per miss
+    calls = 0;
+    NelderMead cached(x0, counted);
+    cached.setToleranceThreshold(1e-12);
+    cached.setMaximumIterations(5000);
+    cached.setCacheCapacity(256);
+    assert(cached.getResult() == expected);
+    assert(calls == cached.getNumberEvaluations() && cached.getCacheMisses() == calls);
+    std::cout << "Rosenbrock in dimension 3, first run: " << cached.getCacheHits() << " hits, " << cached.getCacheMisses() << " misses\n";
+
+    // The entries outlive the run: a restart from the same point replays the whole run from the cache
+    NelderMead replayed(x0, counted);
+    replayed.setToleranceThreshold(1e-12);
+    replayed.setMaximumIterations(5000);
+    replayed.setCacheCapacity(1 << 16);
+    replayed.optimize();
+    long long lookups = replayed.getCacheHits() + replayed.getCacheMisses();
+    replayed.setStartValues(x0);
+    calls = 0;
+    assert(replayed.getResult() == expected);
+    assert(calls == 0 && replayed.getNumberEvaluations() == 0 && replayed.getCacheHits() == lookups);
+    std::cout << "Restart from the same point: " << replayed.getCacheHits() << " hits, " << replayed.getCacheMisses() << " misses\n";
+
+    std::cout << "✅ Nelder-Mead Cache Test Passed!\n\n";
+}
+
+void testNelderMeadParallel() {
+    std::cout << "Testing parallel Nelder-Mead evaluations...\n";
+    std::vector<double> x0(8, -1.0);
+    NelderMead sequential(x0, rosenbrockPointer);
+    sequential.setToleranceThreshold(1e-12);
+    sequential.setMaximumIterations(3000);
+    std::vector<double> expected = sequential.getResult();
+
+    // Concurrent initial simplex and shrink evaluations leave the iterates unchanged
+    NelderMead threaded(x0, rosenbrockPointer);
+    threaded.setToleranceThreshold(1e-12);
+    threaded.setMaximumIterations(3000);
+    threaded.setNumberThreads(3);
+    threaded.setCacheCapacity(128);
+    assert(threaded.getNumberThreads() == 3);
+    assert(threaded.getResult() == expected);
+    assert(threaded.getNumberEvaluations() == sequential.getNumberEvaluations());
+
+    // Parallel directions: same iterates on one thread or several, and a converging simplex
+    NelderMead directions(x0, rosenbrockPointer);
+    directions.setToleranceThreshold(1e-12);
+    directions.setMaximumIterations(20000);
+    directions.setNumberDirections(3);
+    NelderMead threadedDirections(directions);
+    threadedDirections.setNumberThreads(3);
+    assert(directions.getNumberDirections() == 3);
+    assert(threadedDirections.getResult() == directions.getResult());
+    assert(threadedDirections.getNumberEvaluations() == directions.getNumberEvaluations());
+    for (double x : directions.getResult()) assert(std::abs(x - 1.0) < 1e-4);
+    std::cout << "Rosenbrock in dimension 8: classic " << sequential.getNumberIterations() << " iterations, " << sequential.getNumberEvaluations() 
+    << " evaluations (f = " << sequential.getFunctionResult() << "); 3 directions " << directions.getNumberIterations() << " iterations, " 
+    << directions.getNumberEvaluations() << " evaluations (f = " << directions.getFunctionResult() << ")\n";
+
+    // The directions are capped at the dimension
+    NelderMead capped({3.0, 3.0}, himmelblauFunction);
+    capped.setNumberDirections(5);
+    capped.setToleranceThreshold(1e-12);
+    capped.setMaximumIterations(1000);
+    assert(himmelblauFunction(capped.getResult()) < 1e-10);
+    std::cout << "✅ Parallel Nelder-Mead Test Passed!\n\n";
+}
+
+void testNelderMeadParallelTime() {
+    // Expensive objective: every call sums a few thousand terms, as a repricing would.
+    auto expensive = [](const double* x, int n) {
+        double result = rosenbrockPointer(x, n);
+        double noise = 0.0;
+        for (int k = 0; k < 4000; k++) noise += std::sin(k * 1e-3 + x[0]);
+        return result + 1e-30 * noise;
+    };
+    int n = 30;
+    std::vector<double> x0(n, -1.0);
+    std::cout << "Nelder-Mead in dimension " << n << " with an expensive objective, 300 iterations:\n";
+    for (int threads : {1, 4}) {
+        for (int p : {1, 4}) {
+            NelderMead optimizer(x0, expensive);
+            optimizer.setMaximumIterations(300);
+            optimizer.setNumberThreads(threads);
+            optimizer.setNumberDirections(p);
+            optimizer.optimize();
+            std::cout << optimizer.getNumberThreads() << " threads, " << p << " directions: " << optimizer.getNumberEvaluations() 
+            << " evaluations, f = " << optimizer.getFunctionResult() << ", time taken: " << optimizer.getTimeTaken() << "\n";
+        }
+    }
+}
+
 int main()
 {
     testNewtonRaphson();
     testNelderMead();
     testNelderMeadHimmelblau();
+    testNelderMeadObjectiveSignatures();
+    testNelderMeadRosenbrockTime();
+    testBatchOptimizer();
+    testBatchOptimizerTime();
+    testBatchNewtonRaphson();
+    testBatchNewtonRaphsonTime();
+    testBracketedRootFinders();
+    testRootFinderEvaluations();
+    testLBFGS();
+    testLevenbergMarquardt();
+    testOptimizerTrace();
+    testEvaluationCache();
+    testNelderMeadCache();
+    testNelderMeadParallel();
+    testNelderMeadParallelTime();
     return 0;
 }
\ No newline at end of file
@@ -3,7 +3,40 @@
 #include <cmath>
 #include <cassert>
 #include <chrono>
+#include <atomic>
 #include "../include/core-math/quadratures.hpp"
+#include "../include/core-math/threadpool.hpp"
+
+// Reference nodes from the dense eigendecomposition of the Jacobi matrix.
+QuadratureNodes denseGaussLaguerre(int points)
+{
+    Eigen::MatrixXd J = Eigen::MatrixXd::Zero(points, points);
+    for (int k = 0; k < points; k++) J(k, k) = 2.0 * k + 1.0;
+    for (int k = 0; k + 1 < points; k++) J(k, k + 1) = J(k + 1, k) = k + 1.0;
+    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> solver(J);
+    QuadratureNodes nodes;
+    for (int i = 0; i < points; i++)
+    {
+        nodes.roots.push_back(solver.eigenvalues()[i]);
+        nodes.weights.push_back(std::pow(solver.eigenvectors()(0, i), 2));
+    }
+    return nodes;
+}
+
+// Gauss-Laguerre through Golub-Welsch at every size, tables bypassed.
+class GolubWelschLaguerre final: public GaussianQuadrature
+{
+    public: 
+        GolubWelschLaguerre(int points): GaussianQuadrature(points){compute();}
+    protected: 
+        QuadratureNodes computeNodes() const override
+        {
+            std::vector<double> diagonal, offDiagonal;
+            for (int k = 0; k < getPoints(); k++) diagonal.push_back(2.0 * k + 1.0);
+            for (int k = 0; k + 1 < getPoints(); k++) offDiagonal.push_back(k + 1.0);
+            return computeGolubWelsch(diagonal, offDiagonal, 1.0);
+        }
+};
 
 void testGaussLaguerre() {
     // Test the computation of roots and weights
@@ -55,6 +88,393 @@ void testGaussLaguerreHighDimension() {
     assert(std::abs(result - 1.0) < 1e-6);
 }
 
+void testGaussLaguerreTables() {
+    for (const QuadratureTables::Table& table : QuadratureTables::gaussLaguerre)
+    {
+        int points = table.points;
+        QuadratureNodes reference = denseGaussLaguerre(points);
+        double sum = 0.0;
+        for (int i = 0; i < points; i++)
+        {
+            assert(i == 0 || table.roots[i] > table.roots[i - 1]);
+            assert(std::abs(table.roots[i] - reference.roots[i]) < 1e-12 * table.roots[i] + 1e-13);
+            // Eigenvector components only have absolute accuracy, the tables are exact to rounding.
+            assert(std::abs(table.weights[i] - reference.weights[i]) < 1e-13);
+            sum += table.weights[i];
+        }
+        assert(std::abs(sum - 1.0) < 1e-14);
+
+        // Integral of x^k exp(-x) from 0 to infinity is k!, exactly integrated up to k = 2n - 1
+        GaussLaguerreQuadrature gl(points);
+        for (int k = 1; k <= 12; k++)
+        {
+            double result = gl.integrate([k](double x) {return std::pow(x, k);});
+            assert(std::abs(result / std::tgamma(k + 1.0) - 1.0) < 1e-12);
+        }
+    }
+    std::cout << "Gauss-Laguerre tables match the eigensolver" << std::endl;
+}
+
+void testGolubWelsch() {
+    // Nodes and weights match the quad precision tables relative to their size, to the rounding of the recurrence
+    for (const QuadratureTables::Table& table : QuadratureTables::gaussLaguerre)
+    {
+        GolubWelschLaguerre gl(table.points);
+        std::vector<double> roots = gl.getRoots(), weights = gl.getWeights();
+        for (int i = 0; i < table.points; i++)
+        {
+            assert(std::abs(roots[i] / table.roots[i] - 1.0) < 1e-12);
+            assert(std::abs(weights[i] / table.weights[i] - 1.0) < 1e-12);
+        }
+    }
+
+    // And the dense eigensolver, up to its absolute accuracy
+    QuadratureNodes reference = denseGaussLaguerre(300);
+    GolubWelschLaguerre gl(300);
+    std::vector<double> roots = gl.getRoots(), weights = gl.getWeights();
+    for (int i = 0; i < 300; i++)
+    {
+        assert(std::abs(roots[i] - reference.roots[i]) < 1e-12 * roots[i] + 1e-13);
+        assert(std::abs(weights[i] - reference.weights[i]) < 1e-12);
+    }
+
+    // Large rules: the tail weights underflow to zero instead of rounding noise
+    GolubWelschLaguerre large(2000);
+    weights = large.getWeights();
+    double sum = 0.0;
+    for (double weight : weights) {assert(weight >= 0.0); sum += weight;}
+    assert(std::abs(sum - 1.0) < 1e-13);
+    for (int k = 1; k <= 8; k++)
+    {
+        double result = large.integrate([k](double x) {return std::pow(x, k);});
+        assert(std::abs(result / std::tgamma(k + 1.0) - 1.0) < 1e-12);
+    }
+    std::cout << "Golub-Welsch nodes match the tables and the eigensolver" << std::endl;
+}
+
+void testGaussLegendre() {
+    // Exact for polynomials up to degree 2n - 1 on any interval
+    GaussLegendreQuadrature gl(10, 0.0, 2.0);
+    std::vector<double> roots = gl.getRoots(), weights = gl.getWeights();
+    double sum = 0.0;
+    for (int i = 0; i < 10; i++)
+    {
+        assert(roots[i] > 0.0 && roots[i] < 2.0);
+        assert(std::abs(roots[i] + roots[9 - i] - 2.0) < 1e-15 && std::abs(weights[i] - weights[9 - i]) < 1e-15);
+        sum += weights[i];
+    }
+    assert(std::abs(sum - 2.0) < 1e-14);
+    for (int k = 0; k < 20; k++)
+    {
+        double result = gl.integrate([k](double x) {return std::pow(x, k);});
+        assert(std::abs(result / (std::pow(2.0, k + 1) / (k + 1)) - 1.0) < 1e-14);
+    }
+
+    gl.setPoints(12);
+    gl.setInterval(0.0, M_PI);
+    assert(std::abs(gl.integrate([](double x) {return std::sin(x);}) - 2.0) < 1e-14);
+    assert(gl.getLower() == 0.0 && gl.getUpper() == M_PI);
+
+    // Large rules stay accurate
+    GaussLegendreQuadrature large(1000, -1.0, 1.0);
+    assert(std::abs(large.integrate([](double x) {return 1.0 / (1.0 + 25.0 * x * x);}) - 0.4 * std::atan(5.0)) < 1e-14);
+    std::cout << "Gauss-Legendre tests passed" << std::endl;
+}
+
+void testGaussHermite() {
+    GaussHermiteQuadrature gh(20);
+    std::vector<double> roots = gh.getRoots();
+    for (int i = 0; i < 20; i++) assert(std::abs(roots[i] + roots[19 - i]) < 1e-14);
+
+    // Integral of x^(2k) exp(-x^2) over the real line is Gamma(k + 1/2)
+    for (int k = 0; k < 20; k++)
+    {
+        double result = gh.integrate([k](double x) {return std::pow(x, 2 * k);});
+        assert(std::abs(result / std::tgamma(k + 0.5) - 1.0) < 1e-13);
+    }
+    double result = gh.integrate([](double x) {return std::cos(x);});
+    assert(std::abs(result - std::sqrt(M_PI) * std::exp(-0.25)) < 1e-15);
+    std::cout << "Gauss-Hermite tests passed" << std::endl;
+}
+
+void testGeneralizedGaussLaguerre() {
+    // Integral of x^k x^alpha exp(-x) over [0, infinity) is Gamma(k + alpha + 1)
+    for (double alpha : {-0.5, 0.5, 2.5})
+    {
+        GaussLaguerreQuadrature gl(30, alpha);
+        assert(gl.getAlpha() == alpha);
+        for (int k = 0; k < 15; k++)
+        {
+            double result = gl.integrate([k](double x) {return std::pow(x, k);});
+            assert(std::abs(result / std::tgamma(k + alpha + 1.0) - 1.0) < 1e-12);
+        }
+    }
+
+    // alpha = 0 is the classical rule, and each alpha has its own cache entry
+    QuadratureNodeCache::clear();
+    GaussLaguerreQuadrature classical(32), explicitZero(32, 0.0), other(32, 0.5);
+    assert(classical.getRoots() == explicitZero.getRoots() && classical.getRoots() != other.getRoots());
+    assert(QuadratureNodeCache::getSize() == 2);
+
+    try {
+        GaussLaguerreQuadrature invalid(10, -1.0);
+        assert(false);
+    } catch (const MathErrorRegistry::Quadrature::InvalidLaguerreAlphaError &e) {
+        std::cout << e.what() << std::endl;
+    }
+    std::cout << "Generalized Gauss-Laguerre tests passed" << std::endl;
+}
+
+void testGaussKronrod() {
+    for (int n : {7, 10})
+    {
+        GaussKronrodQuadrature gk(n);
+        std::vector<double> roots = gk.getRoots(), weights = gk.getWeights(), gaussWeights = gk.getGaussWeights();
+        assert(static_cast<int>(roots.size()) == 2 * n + 1);
+
+        // The embedded nodes are the Gauss-Legendre ones, with the same weights
+        std::vector<double> gaussRoots = GaussLegendreQuadrature(n).getRoots(), legendreWeights = GaussLegendreQuadrature(n).getWeights();
+        double kronrodSum = 0.0, gaussSum = 0.0;
+        for (int i = 0, j = 0; i < 2 * n + 1; i++)
+        {
+            assert(i == 0 || roots[i] > roots[i - 1]);
+            kronrodSum += weights[i];
+            gaussSum += gaussWeights[i];
+            if (gaussWeights[i] == 0.0) continue;
+            assert(std::abs(roots[i] - gaussRoots[j]) < 1e-15 && std::abs(gaussWeights[i] - legendreWeights[j]) < 1e-15);
+            j++;
+        }
+        assert(std::abs(kronrodSum - 2.0) < 1e-15 && std::abs(gaussSum - 2.0) < 1e-15);
+
+        // Kronrod rules are exact up to degree 3n + 1, the embedded Gauss rule up to 2n - 1
+        for (int k = 0; k <= 3 * n + 1; k++)
+        {
+            double exact = k % 2 == 0 ? 2.0 / (k + 1) : 0.0;
+            double error = 0.0;
+            assert(std::abs(gk.integrate([k](double x) {return std::pow(x, k);}, error) - exact) < 1e-15);
+            assert(k >= 2 * n || error < 1e-13);
+        }
+        double error = 0.0;
+        gk.integrate([n](double x) {return std::pow(x, 2 * n);}, error);
+        assert(error > 1e-8);
+
+        // The error estimate bounds the actual error
+        gk.setInterval(0.0, 1.0);
+        std::vector<std::pair<std::function<double(double)>, double>> cases = {
+            {[](double x) {return std::exp(x);}, std::exp(1.0) - 1.0},
+            {[](double x) {return std::sqrt(x);}, 2.0 / 3.0},
+            {[](double x) {return 1.0 / (1.0 + 25.0 * x * x);}, 0.2 * std::atan(5.0)},
+            {[](double x) {return std::log(x);}, -1.0}};
+        for (const auto& [f, exact] : cases)
+        {
+            double result = gk.integrate(f, error);
+            assert(std::abs(result - exact) <= error);
+        }
+    }
+
+    try {
+        GaussKronrodQuadrature invalid(8);
+        assert(false);
+    } catch (const MathErrorRegistry::Quadrature::UnsupportedKronrodRuleError &e) {
+        std::cout << e.what() << std::endl;
+    }
+    std::cout << "Gauss-Kronrod tests passed" << std::endl;
+}
+
+void testAdaptiveQuadrature() {
+    struct Case {std::function<double(double)> f; double lower; double upper; double exact;};
+    std::vector<Case> cases = {
+        {[](double x) {return std::sqrt(x);}, 0.0, 1.0, 2.0 / 3.0},
+        {[](double x) {return std::log(x);}, 0.0, 1.0, -1.0},
+        {[](double x) {return std::sin(x) * std::sin(x);}, 0.0, 10.0 * M_PI, 5.0 * M_PI},
+        {[](double x) {return 1.0 / (1e-4 + x * x);}, -1.0, 1.0, 200.0 * std::atan(100.0)},
+        {[](double x) {return std::exp(x);}, 1.0, 0.0, 1.0 - std::exp(1.0)}};
+
+    for (int threads : {1, 4})
+    {
+        for (int rule : {7, 10})
+        {
+            AdaptiveQuadrature adaptive(1e-12, 1e-12, threads);
+            adaptive.setRule(rule);
+            assert(adaptive.getRule() == rule && adaptive.getNumberThreads() == threads);
+            for (const Case& c : cases)
+            {
+                double result = adaptive.integrate(c.f, c.lower, c.upper);
+                assert(adaptive.isConverged());
+                assert(adaptive.getError() <= std::max(1e-12, 1e-12 * std::abs(result)));
+                assert(std::abs(result - c.exact) <= std::max(adaptive.getError(), 1e-14 * std::abs(c.exact)));
+                assert(adaptive.getTimeTaken() >= 0.0);
+                // Every bisection integrates two halves with the 2n + 1 point rule
+                int bisections = adaptive.getNumberSubintervals() - 1;
+                assert(adaptive.getNumberEvaluations() == (2 * rule + 1) * (1 + 2 * bisections));
+            }
+        }
+    }
+
+    // Relative tolerance alone: the smaller tolerance needs more subintervals
+    AdaptiveQuadrature relative(0.0, 1e-6);
+    relative.integrate(cases[0].f, 0.0, 1.0);
+    int coarse = relative.getNumberSubintervals();
+    relative.setRelativeTolerance(1e-12);
+    relative.integrate(cases[0].f, 0.0, 1.0);
+    assert(relative.isConverged() && relative.getNumberSubintervals() > coarse);
+
+    // The subinterval limit stops the refinement, with the error estimate reached so far
+    AdaptiveQuadrature limited(1e-14, 0.0);
+    limited.setMaxSubintervals(10);
+    double result = limited.integrate([](double x) {return std::pow(x, -0.9);}, 0.0, 1.0);
+    assert(!limited.isConverged() && limited.getNumberSubintervals() == 10);
+    assert(std::abs(result - 10.0) <= limited.getError());
+
+    try {
+        limited.setRule(8);
+        assert(false);
+    } catch (const MathErrorRegistry::Quadrature::UnsupportedKronrodRuleError &e) {
+        std::cout << e.what() << std::endl;
+    }
+    assert(limited.getRule() == 7);
+    std::cout << "Adaptive quadrature tests passed" << std::endl;
+}
+
+void testAdaptiveQuadratureTime() {
+    // Expensive, peaked integrand: the adaptive rule spends its evaluations around the peak.
+    std::atomic<int> calls(0);
+    auto f = [&calls](double x) {
+        calls++;
+        double result = 0.0;
+        for (int k = 1; k <= 200; k++) result += std::cos(1e-3 * k * x);
+        return result / (1e-4 + x * x);
+    };
+
+    GaussLegendreQuadrature fixed(2000, -1.0, 1.0);
+    auto start = std::chrono::high_resolution_clock::now();
+    double reference = fixed.integrate(f);
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> elapsed = end - start;
+    std::cout << "Time taken for a 2000 point Gauss-Legendre rule: " << elapsed.count() << " seconds" << std::endl;
+
+    for (int threads : {1, 4})
+    {
+        AdaptiveQuadrature adaptive(1e-10, 1e-12, threads);
+        double result = adaptive.integrate(f, -1.0, 1.0);
+        assert(adaptive.isConverged() && std::abs(result - reference) < 1e-8 * std::abs(reference));
+        std::cout << "Time taken for adaptive G7K15 (" << adaptive.getNumberThreads() << " threads): " << adaptive.getTimeTaken() << " seconds, "
+                  << adaptive.getNumberEvaluations() << " evaluations, " << adaptive.getNumberSubintervals() << " subintervals, error "
+                  << adaptive.getError() << std::endl;
+    }
+}
+
+void testBatchedIntegration() {
+    // One call at all the nodes gives the scalar result, with and without a change of variable
+    GaussLegendreQuadrature legendre(12, 0.0, M_PI);
+    double batched = legendre.integrate([](const Eigen::Ref<const Eigen::VectorXd>& x, Eigen::Ref<Eigen::VectorXd> values) {values = x.array().sin();});
+    assert(std::abs(batched - legendre.integrate([](double x) {return std::sin(x);})) < 1e-15 && std::abs(batched - 2.0) < 1e-14);
+    GaussLaguerreQuadrature laguerre(32);
+    batched = laguerre.integrate([](const Eigen::Ref<const Eigen::VectorXd>& x, Eigen::Ref<Eigen::VectorXd> values) {values = x.array().square();});
+    assert(std::abs(batched - 2.0) < 1e-13);
+
+    // Matrix of integrands: integral of x^j exp(-x) is j!
+    int functions = 11;
+    Eigen::VectorXd integrals(functions);
+    laguerre.integrate([functions](const Eigen::Ref<const Eigen::VectorXd>& x, Eigen::Ref<Eigen::MatrixXd> values) {
+        values.col(0).setOnes();
+        for (int j = 1; j < functions; j++) values.col(j) = values.col(j - 1).cwiseProduct(x);
+    }, integrals);
+    for (int j = 0; j < functions; j++)
+    {
+        assert(std::abs(integrals[j] / std::tgamma(j + 1.0) - 1.0) < 1e-12);
+        assert(std::abs(integrals[j] - laguerre.integrate([j](double x) {return std::pow(x, j);})) < 1e-12 * integrals[j]);
+    }
+
+    // Gauss-Kronrod error estimates and adaptive integration
+    GaussKronrodQuadrature kronrod(7, 0.0, 1.0);
+    auto sqrtBatch = [](const Eigen::Ref<const Eigen::VectorXd>& x, Eigen::Ref<Eigen::VectorXd> values) {values = x.array().sqrt();};
+    double error = 0.0, scalarError = 0.0;
+    batched = kronrod.integrate(sqrtBatch, error);
+    double scalar = kronrod.integrate([](double x) {return std::sqrt(x);}, scalarError);
+    assert(std::abs(batched - scalar) < 1e-15 && std::abs(error - scalarError) < 1e-15);
+
+    for (int threads : {1, 4})
+    {
+        AdaptiveQuadrature adaptive(1e-12, 1e-12, threads);
+        batched = adaptive.integrate(sqrtBatch, 0.0, 1.0);
+        assert(adaptive.isConverged() && std::abs(batched - 2.0 / 3.0) <= adaptive.getError());
+        int evaluations = adaptive.getNumberEvaluations();
+        scalar = adaptive.integrate([](double x) {return std::sqrt(x);}, 0.0, 1.0);
+        assert(std::abs(batched - scalar) < 1e-15 && adaptive.getNumberEvaluations() == evaluations);
+    }
+    std::cout << "Batched integration tests passed" << std::endl;
+}
+
+void testBatchedIntegrationTime() {
+    // Characteristic function of an exponential law: integral of cos(u x) exp(-x) is 1 / (1 + u^2), for many u.
+    int points = 1000, functions = 200;
+    GaussLaguerreQuadrature laguerre(points);
+    Eigen::VectorXd u = Eigen::VectorXd::LinSpaced(functions, 0.0, 1.0), scalar(functions), batched(functions);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int j = 0; j < functions; j++) scalar[j] = laguerre.integrate([&u, j](double x) {return std::cos(u[j] * x);});
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> elapsed = end - start;
+    std::cout << "Time taken for " << functions << " integrands with " << points << " points (scalar calls): " << elapsed.count() << " seconds" << std::endl;
+
+    start = std::chrono::high_resolution_clock::now();
+    for (int j = 0; j < functions; j++)
+    {
+        batched[j] = laguerre.integrate([&u, j](const Eigen::Ref<const Eigen::VectorXd>& x, Eigen::Ref<Eigen::VectorXd> values) {values = (u[j] * x).array().cos();});
+    }
+    end = std::chrono::high_resolution_clock::now();
+    elapsed = end - start;
+    std::cout << "Time taken for " << functions << " integrands with " << points << " points (batched calls): " << elapsed.count() << " seconds" << std::endl;
+    assert((batched - scalar).lpNorm<Eigen::Infinity>() < 1e-13);
+
+    // The value matrix is allocated by the first call only.
+    auto kernel = [&u](const Eigen::Ref<const Eigen::VectorXd>& x, Eigen::Ref<Eigen::MatrixXd> values) {values.noalias() = x * u.transpose(); values = values.array().cos();};
+    for (int run = 0; run < 2; run++)
+    {
+        start = std::chrono::high_resolution_clock::now();
+        laguerre.integrate(kernel, batched);
+        end = std::chrono::high_resolution_clock::now();
+        elapsed = end - start;
+        std::cout << "Time taken for " << functions << " integrands with " << points << " points (one matrix call" << (run == 0 ? "" : ", buffers kept") << "): " << elapsed.count() << " seconds" << std::endl;
+    }
+    assert((batched - scalar).lpNorm<Eigen::Infinity>() < 1e-13);
+    assert((batched.array() - 1.0 / (1.0 + u.array().square())).abs().maxCoeff() < 1e-10);
+}
+
+void testQuadratureNodeCache() {
+    QuadratureNodeCache::clear();
+    assert(QuadratureNodeCache::getSize() == 0);
+
+    // Instances with the same rule and size share one entry, built once
+    GaussLaguerreQuadrature first(40), second(40);
+    assert(QuadratureNodeCache::getSize() == 1);
+    assert(first.getRoots() == second.getRoots() && first.getWeights() == second.getWeights());
+    second.setPoints(41);
+    assert(!second.isComputed() && QuadratureNodeCache::getSize() == 1);
+    second.compute();
+    assert(second.getRoots().size() == 41 && QuadratureNodeCache::getSize() == 2);
+    second.setPoints(40);
+    second.compute();
+    assert(QuadratureNodeCache::getSize() == 2);
+
+    // Concurrent first uses of the same sizes build consistent entries
+    QuadratureNodeCache::clear();
+    ThreadPool pool(4);
+    std::vector<double> results(64);
+    pool.parallelFor(64, [&results](int i) {
+        GaussLaguerreQuadrature gl(30 + i % 4);
+        results[i] = gl.integrate([](double x) {return x * x;});
+    });
+    assert(QuadratureNodeCache::getSize() == 4);
+    for (double result : results) assert(std::abs(result - 2.0) < 1e-12);
+    for (int i = 0; i < 4; i++)
+    {
+        assert(results[i] == results[i + 4]);
+    }
+    std::cout << "Quadrature node cache shared across instances and threads" << std::endl;
+}
+
 void testGaussLaguerreTime()
 {
     // Test the timing of Gauss-Laguerre quadrature
@@ -64,13 +484,73 @@ void testGaussLaguerreTime()
     auto end = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double> elapsed = end - start;
     std::cout << "Time taken to compute Gauss-Laguerre quadrature with " << points << " points: " << elapsed.count() << " seconds" << std::endl;
+
+    // Later instances only look the nodes up
+    int instances = 1000;
+    start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < instances; i++) GaussLaguerreQuadrature cached(points);
+    end = std::chrono::high_resolution_clock::now();
+    elapsed = end - start;
+    std::cout << "Time taken to construct " << instances << " cached Gauss-Laguerre quadratures with " << points << " points: " << elapsed.count() << " seconds" << std::endl;
+
+    // Tabulated sizes skip the eigensolver on first use
+    QuadratureNodeCache::clear();
+    start = std::chrono::high_resolution_clock::now();
+    GaussLaguerreQuadrature tabulated(128);
+    end = std::chrono::high_resolution_clock::now();
+    elapsed = end - start;
+    std::cout << "Time taken to compute Gauss-Laguerre quadrature with 128 points (table): " << elapsed.count() << " seconds" << std::endl;
+    start = std::chrono::high_resolution_clock::now();
+    QuadratureNodes dense = denseGaussLaguerre(128);
+    end = std::chrono::high_resolution_clock::now();
+    elapsed = end - start;
+    std::cout << "Time taken to compute Gauss-Laguerre quadrature with 128 points (eigensolver): " << elapsed.count() << " seconds" << std::endl;
+
+    // Finite interval: trapezoid rule against Gauss-Legendre
+    auto f = [](double x) {return std::exp(-x) * std::sin(3.0 * x);};
+    double exact = 0.1 * (3.0 - std::exp(-M_PI) * (std::sin(3.0 * M_PI) + 3.0 * std::cos(3.0 * M_PI)));
+    for (int n : {100, 10000})
+    {
+        double h = M_PI / n, trapezoid = 0.5 * (f(0.0) + f(M_PI));
+        for (int i = 1; i < n; i++) trapezoid += f(i * h);
+        trapezoid *= h;
+        std::cout << "Error of the trapezoid rule with " << n + 1 << " evaluations: " << std::abs(trapezoid - exact) << std::endl;
+    }
+    GaussLegendreQuadrature legendre(16, 0.0, M_PI);
+    std::cout << "Error of Gauss-Legendre with 16 evaluations: " << std::abs(legendre.integrate(f) - exact) << std::endl;
+
+    // Golub-Welsch against the dense eigensolver it replaced
+    start = std::chrono::high_resolution_clock::now();
+    dense = denseGaussLaguerre(points);
+    end = std::chrono::high_resolution_clock::now();
+    elapsed = end - start;
+    std::cout << "Time taken to compute Gauss-Laguerre quadrature with " << points << " points (eigensolver): " << elapsed.count() << " seconds" << std::endl;
+    for (int n : {points, 1000, 5000})
+    {
+        start = std::chrono::high_resolution_clock::now();
+        GolubWelschLaguerre golubWelsch(n);
+        end = std::chrono::high_resolution_clock::now();
+        elapsed = end - start;
+        std::cout << "Time taken to compute Gauss-Laguerre quadrature with " << n << " points (Golub-Welsch): " << elapsed.count() << " seconds" << std::endl;
+    }
 }
 
 int main() {
     std::cout << "Testing Gauss-Laguerre Quadrature:\n";
     testGaussLaguerre();
     testGaussLaguerreHighDimension();
+    testGaussLaguerreTables();
+    testGolubWelsch();
+    testGaussLegendre();
+    testGaussHermite();
+    testGeneralizedGaussLaguerre();
+    testGaussKronrod();
+    testAdaptiveQuadrature();
+    testBatchedIntegration();
+    testQuadratureNodeCache();
     testGaussLaguerreTime();
+    testAdaptiveQuadratureTime();
+    testBatchedIntegrationTime();
     std::cout << "All tests passed successfully!" << std::endl;
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,138 @@
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <random>
+#include "../include/core-math/surfaceinterpolation.hpp"
+
+// Reference: one spline per expiry row at the strike, then a spline across the rows, built on every query.
+double naive_surface(const std::vector<double>& strikes, const std::vector<double>& expiries, const Eigen::MatrixXd& values, double strike, double expiry)
+{
+    std::vector<double> column(expiries.size());
+    for (std::size_t i = 0; i < expiries.size(); i++)
+    {
+        std::vector<double> row(values.cols());
+        for (int j = 0; j < values.cols(); j++) row[j] = values(i, j);
+        column[i] = CubicSpline(strikes, row).evaluate(strike);
+    }
+    return CubicSpline(expiries, column).evaluate(expiry);
+}
+
+void test_surface_interpolation()
+{
+    std::cout << "Testing surface interpolation..." << std::endl;
+
+    std::vector<double> strikes = {60.0, 80.0, 90.0, 100.0, 110.0, 120.0, 150.0};
+    std::vector<double> expiries = {0.1, 0.25, 0.5, 1.0, 2.0};
+    Eigen::MatrixXd volatilities(expiries.size(), strikes.size());
+    for (std::size_t i = 0; i < expiries.size(); i++)
+    {
+        for (std::size_t j = 0; j < strikes.size(); j++)
+        {
+            double moneyness = std::log(strikes[j] / 100.0);
+            volatilities(i, j) = 0.2 + 0.1 * moneyness * moneyness / std::sqrt(expiries[i]) - 0.02 * expiries[i];
+        }
+    }
+    SurfaceInterpolation bicubic(strikes, expiries, volatilities);
+    assert(bicubic.getMethod() == SurfaceInterpolation::Method::BICUBIC);
+    assert(bicubic.getNumberStrikes() == 7 && bicubic.getNumberExpiries() == 5);
+
+    // Knot values are reproduced, and the surface agrees with splining the row splines
+    for (std::size_t i = 0; i < expiries.size(); i++)
+    {
+        for (std::size_t j = 0; j < strikes.size(); j++) assert(std::abs(bicubic.evaluate(strikes[j], expiries[i]) - volatilities(i, j)) < 1e-14);
+    }
+    std::mt19937 generator(7);
+    std::uniform_real_distribution<double> strikeDistribution(60.0, 150.0), expiryDistribution(0.1, 2.0);
+    std::vector<double> pointStrikes, pointExpiries, out;
+    for (int k = 0; k < 200; k++)
+    {
+        pointStrikes.push_back(strikeDistribution(generator));
+        pointExpiries.push_back(expiryDistribution(generator));
+    }
+    pointStrikes.push_back(150.0);
+    pointExpiries.push_back(2.0);
+    assert(bicubic.evaluate(pointStrikes, pointExpiries, out));
+    for (std::size_t k = 0; k < pointStrikes.size(); k++)
+    {
+        double expected = naive_surface(strikes, expiries, volatilities, pointStrikes[k], pointExpiries[k]);
+        assert(std::abs(out[k] - expected) < 1e-13);
+        assert(out[k] == bicubic.evaluate(pointStrikes[k], pointExpiries[k]));
+    }
+
+    // Bilinear interpolation reproduces functions linear in each variable
+    Eigen::MatrixXd bilinearValues(expiries.size(), strikes.size());
+    for (std::size_t i = 0; i < expiries.size(); i++)
+    {
+        for (std::size_t j = 0; j < strikes.size(); j++) bilinearValues(i, j) = 1.0 + 0.01 * strikes[j] - 0.3 * expiries[i] + 0.002 * strikes[j] * expiries[i];
+    }
+    SurfaceInterpolation bilinear(strikes, expiries, bilinearValues, SurfaceInterpolation::Method::BILINEAR);
+    bilinear.evaluate(pointStrikes, pointExpiries, out);
+    for (std::size_t k = 0; k < pointStrikes.size(); k++)
+    {
+        double expected = 1.0 + 0.01 * pointStrikes[k] - 0.3 * pointExpiries[k] + 0.002 * pointStrikes[k] * pointExpiries[k];
+        assert(std::abs(out[k] - expected) < 1e-13);
+    }
+
+    pointStrikes.push_back(155.0);
+    pointExpiries.push_back(1.0);
+    assert(!bicubic.evaluate(pointStrikes, pointExpiries, out) && std::isnan(out.back()));
+    try {
+        bicubic.evaluate(100.0, 3.0);
+        assert(false);
+    } catch (const MathErrorRegistry::CurveInterpolation::OutOfRangeCurveInterpolationError &e) {
+        std::cout << e.what() << std::endl;
+    }
+    try {
+        SurfaceInterpolation mismatch(strikes, expiries, volatilities.transpose());
+        assert(false);
+    } catch (const MathErrorRegistry::CurveInterpolation::MismatchVectorSizeError &e) {
+        std::cout << e.what() << std::endl;
+    }
+
+    std::cout << "Surface Interpolation Tests Passed!" << std::endl;
+}
+
+void test_surface_interpolation_time()
+{
+    int numberStrikes = 50, numberExpiries = 20, size = 20000;
+    std::vector<double> strikes(numberStrikes), expiries(numberExpiries);
+    for (int j = 0; j < numberStrikes; j++) strikes[j] = 50.0 + 2.0 * j;
+    for (int i = 0; i < numberExpiries; i++) expiries[i] = 0.1 * (i + 1) * (i + 1);
+    Eigen::MatrixXd values(numberExpiries, numberStrikes);
+    for (int i = 0; i < numberExpiries; i++)
+    {
+        for (int j = 0; j < numberStrikes; j++) values(i, j) = 0.2 + 0.05 * std::sin(0.1 * strikes[j]) * std::exp(-0.1 * expiries[i]);
+    }
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> strikeDistribution(strikes.front(), strikes.back()), expiryDistribution(expiries.front(), expiries.back());
+    std::vector<double> pointStrikes(size), pointExpiries(size), out(size);
+    for (int k = 0; k < size; k++) {pointStrikes[k] = strikeDistribution(generator); pointExpiries[k] = expiryDistribution(generator);}
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int k = 0; k < size; k++) out[k] = naive_surface(strikes, expiries, values, pointStrikes[k], pointExpiries[k]);
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> naive = end - start;
+
+    start = std::chrono::high_resolution_clock::now();
+    SurfaceInterpolation surface(strikes, expiries, values);
+    surface.evaluate(pointStrikes, pointExpiries, out);
+    end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> precomputed = end - start;
+
+    start = std::chrono::high_resolution_clock::now();
+    SurfaceInterpolation bilinear(strikes, expiries, values, SurfaceInterpolation::Method::BILINEAR);
+    bilinear.evaluate(pointStrikes, pointExpiries, out);
+    end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> linear = end - start;
+
+    std::cout << "Time taken for " << size << " surface queries (splines built per query): " << naive.count() << " seconds" << std::endl;
+    std::cout << "Time taken for " << size << " surface queries (bicubic, construction included): " << precomputed.count() << " seconds" << std::endl;
+    std::cout << "Time taken for " << size << " surface queries (bilinear, construction included): " << linear.count() << " seconds" << std::endl;
+}
+
+int main()
+{
+    test_surface_interpolation();
+    test_surface_interpolation_time();
+    return 0;
+}
@@ -0,0 +1,95 @@
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <cassert>
+#include <chrono>
+#include <numeric>
+#include <stdexcept>
+#include "../include/core-math/threadpool.hpp"
+
+void test_thread_pool()
+{
+    std::cout << "Testing thread pool..." << std::endl;
+
+    ThreadPool pool(4);
+    assert(pool.getNumberThreads() == 4);
+
+    // Every index runs exactly once
+    std::vector<int> counts(1000, 0);
+    pool.parallelFor(counts.size(), [&counts](int i) {counts[i]++;});
+    for (int count : counts) assert(count == 1);
+
+    std::atomic<int> total(0);
+    for (int i = 0; i < 100; i++) pool.submit([&total, i]() {total += i;});
+    pool.wait();
+    assert(total == 4950);
+
+    // Tasks may wait on the pool themselves: nested loops do not deadlock, even on one thread
+    ThreadPool single(1);
+    std::vector<std::vector<int>> nested(8, std::vector<int>(50, 0));
+    single.parallelFor(8, [&](int i) {
+        single.parallelFor(50, [&, i](int j) {nested[i][j] = i * j;});
+    });
+    for (int i = 0; i < 8; i++) for (int j = 0; j < 50; j++) assert(nested[i][j] == i * j);
+
+    // wait() from a task waits for the tasks it submitted, not for itself or for other waiting tasks
+    std::atomic<int> inner(0);
+    for (ThreadPool* waiting : {&single, &pool}) {
+        for (int i = 0; i < 8; i++) {
+            waiting->submit([waiting, &inner]() {
+                for (int j = 0; j < 10; j++) waiting->submit([&inner]() {inner++;});
+                waiting->wait();
+            });
+        }
+        waiting->wait();
+    }
+    assert(inner == 160);
+
+    // Exceptions reach the waiting thread once the other tasks are done
+    std::atomic<int> done(0);
+    try {
+        pool.parallelFor(20, [&done](int i) {
+            if (i == 7) throw std::runtime_error("task failure");
+            done++;
+        });
+        assert(false);
+    } catch (const std::runtime_error& e) {
+        std::cout << e.what() << std::endl;
+    }
+    assert(done == 19);
+
+    std::cout << "Thread Pool Tests Passed!" << std::endl;
+}
+
+void test_thread_pool_time()
+{
+    // Uneven tasks: the cost of task i grows with i, so a static split would leave threads idle.
+    int tasks = 512;
+    std::vector<double> results(tasks);
+    auto work = [&results](int i) {
+        double sum = 0.0;
+        for (int k = 0; k < 200 * (i + 1); k++) sum += std::sin(k * 1e-3);
+        results[i] = sum;
+    };
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < tasks; i++) work(i);
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> sequential = end - start;
+
+    ThreadPool pool;
+    start = std::chrono::high_resolution_clock::now();
+    pool.parallelFor(tasks, work);
+    end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> parallel = end - start;
+
+    std::cout << "Time taken for " << tasks << " uneven tasks (sequential): " << sequential.count() << " seconds" << std::endl;
+    std::cout << "Time taken for " << tasks << " uneven tasks (" << pool.getNumberThreads() << " threads): " << parallel.count() << " seconds" << std::endl;
+}
+
+int main()
+{
+    test_thread_pool();
+    test_thread_pool_time();
+    return 0;
+}